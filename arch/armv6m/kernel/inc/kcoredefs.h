@@ -37,6 +37,10 @@ extern unsigned long RK_gSysTickInterval;
 #define RK_CORE_SYSTICK_IRQN             ((int)-1)
 
 void kCoreInit(void);
+#if (RK_CONF_TICKLESS == ON)
+unsigned long kCoreTicklessMaxTicks(void);
+unsigned long kCoreTicklessSleep(unsigned long);
+#endif
 
 /* Assembly Helpers - ARMv6-M (Cortex-M0) compatible versions */
 #define RK_DMB RK_ASM volatile("DMB" ::: "memory");
@@ -69,6 +73,7 @@ static inline void kExitCR(unsigned state)
 
 #define RK_HW_REG(addr) *((volatile unsigned long *)(addr))
 #define RK_REG_SCB_ICSR RK_HW_REG(0xE000ED04)
+#define RK_SCB_ICSR_PENDSTSET (1UL << 26)
 #define RK_REG_SYSTICK_CTRL RK_HW_REG(0xE000E010)
 #define RK_REG_SYSTICK_LOAD RK_HW_REG(0xE000E014)
 #define RK_REG_SYSTICK_VAL RK_HW_REG(0xE000E018)
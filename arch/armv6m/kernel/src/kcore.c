@@ -28,6 +28,14 @@ unsigned long RK_gSyTickDiv = RK_CONF_SYSTICK_DIV;
 unsigned long RK_gSyTickDiv = 0;
 #endif
 
+#if (RK_CONF_TICKLESS == ON)
+#define RK_SYSTICK_CTRL_ENABLE (1UL << 0)
+#define RK_SCB_ICSR_PENDSVSET (1UL << 28)
+
+/* core clock cycles per kernel tick, latched when SysTick is configured */
+static unsigned long RK_gSysTickCyclesPerTick = 0UL;
+#endif
+
 static inline unsigned kCoreSysTickConfig_(unsigned ticks)
 {
     /* check if number of ticks is valid (24-bit reload) */
@@ -45,6 +53,9 @@ static inline unsigned kCoreSysTickConfig_(unsigned ticks)
 
     /* Set reload register */
     RK_REG_SYSTICK_LOAD = (ticks - 1U);
+#if (RK_CONF_TICKLESS == ON)
+    RK_gSysTickCyclesPerTick = ticks;
+#endif
     /* Reset the SysTick counter */
     RK_REG_SYSTICK_VAL = 0;
     /* keep interrupt disabled; clock source = core */
@@ -59,6 +70,107 @@ static inline unsigned kCoreSysTickConfig_(unsigned ticks)
     return (0);
 }
 
+#if (RK_CONF_TICKLESS == ON)
+unsigned long kCoreTicklessMaxTicks(void)
+{
+    if (RK_gSysTickCyclesPerTick == 0UL)
+    {
+        return (0UL);
+    }
+    /* the stretched period must still fit the 24-bit reload */
+    return (0xFFFFFFUL / RK_gSysTickCyclesPerTick);
+}
+
+/*
+ * Runs with interrupts masked. Stretches the current SysTick period so the
+ * next interrupt lands idleTicks tick boundaries ahead, sleeps, and restores
+ * the regular period on wake-up.
+ * Returns the number of tick boundaries that went by without a SysTick
+ * interrupt. The boundary that does raise one is left pending, so
+ * kTickHandler() accounts for it as soon as interrupts are unmasked.
+ */
+unsigned long kCoreTicklessSleep(unsigned long idleTicks)
+{
+    unsigned long const cycles = RK_gSysTickCyclesPerTick;
+    unsigned long const maxTicks = kCoreTicklessMaxTicks();
+    unsigned long const ctrl = RK_REG_SYSTICK_CTRL;
+
+    if ((cycles < 2UL) || ((ctrl & RK_SYSTICK_CTRL_ENABLE) == 0UL))
+    {
+        return (0UL);
+    }
+    if (idleTicks > maxTicks)
+    {
+        idleTicks = maxTicks;
+    }
+    if (idleTicks < 2UL)
+    {
+        return (0UL);
+    }
+
+    RK_REG_SYSTICK_CTRL = (ctrl & ~RK_SYSTICK_CTRL_ENABLE);
+
+    /* a tick or a context switch is already due: nothing to stretch */
+    unsigned long const partial = RK_REG_SYSTICK_VAL;
+    if ((partial == 0UL) ||
+        ((RK_REG_SCB_ICSR &
+          (RK_SCB_ICSR_PENDSTSET | RK_SCB_ICSR_PENDSVSET)) != 0UL))
+    {
+        RK_REG_SYSTICK_CTRL = (ctrl | RK_SYSTICK_CTRL_ENABLE);
+        return (0UL);
+    }
+
+    /* what is left of this tick plus (idleTicks - 1) whole ticks */
+    unsigned long const sleepCycles = partial + ((idleTicks - 1UL) * cycles);
+    RK_REG_SYSTICK_LOAD = (sleepCycles - 1UL);
+    RK_REG_SYSTICK_VAL = 0UL;
+    RK_REG_SYSTICK_CTRL = (ctrl | RK_SYSTICK_CTRL_ENABLE);
+
+    RK_DSB
+    RK_WFI
+    RK_ISB
+
+    RK_REG_SYSTICK_CTRL = (ctrl & ~RK_SYSTICK_CTRL_ENABLE);
+
+    unsigned long elapsed = 0UL;
+    unsigned long next = 0UL;
+    unsigned long const remaining = RK_REG_SYSTICK_VAL;
+
+    if ((RK_REG_SCB_ICSR & RK_SCB_ICSR_PENDSTSET) != 0UL)
+    {
+        /* slept the whole window; the counter has reloaded since */
+        unsigned long const late = (sleepCycles - 1UL) - remaining;
+        elapsed = idleTicks - 1UL;
+        next = (late < (cycles - 2UL)) ? (cycles - late) : cycles;
+    }
+    else
+    {
+        /* woken early by another interrupt */
+        elapsed = (idleTicks - 1UL) - (remaining / cycles);
+        next = remaining % cycles;
+        if ((next < 2UL) && (elapsed < (idleTicks - 1UL)))
+        {
+            /* woke right on a tick boundary: count it here */
+            elapsed += 1UL;
+            next += cycles;
+        }
+        if (next < 2UL)
+        {
+            next = 2UL;
+        }
+    }
+
+    /* finish the current tick, then fall back to the regular period, which
+     * the counter only latches on its next reload */
+    RK_REG_SYSTICK_LOAD = (next - 1UL);
+    RK_REG_SYSTICK_VAL = 0UL;
+    RK_REG_SYSTICK_CTRL = (ctrl | RK_SYSTICK_CTRL_ENABLE);
+    RK_REG_SYSTICK_LOAD = (cycles - 1UL);
+
+    return (elapsed);
+}
+#endif
+
 static inline void kCoreSetInterruptPriority_(int IRQn, unsigned priority)
 {
     /* ARMv6-M supports 4 priority levels (bits 7:6) */
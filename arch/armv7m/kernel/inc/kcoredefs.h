@@ -36,6 +36,14 @@ extern unsigned long RK_gSysTickInterval;
 #define RK_CORE_SYSTICK_IRQN ((int)-1)
 
 void kCoreInit(void);
+#if (RK_CONF_TICKLESS == ON)
+unsigned long kCoreTicklessMaxTicks(void);
+unsigned long kCoreTicklessSleep(unsigned long);
+#endif
+#if (RK_CONF_HRTIMER == ON)
+void kCoreHrTimerArm(unsigned long);
+void kCoreHrTimerStop(void);
+#endif
 
 /* Assembly Helpers */
 #define RK_DMB RK_ASM volatile("DMB" :: : "memory");
@@ -45,6 +53,29 @@ void kCoreInit(void);
 #define RK_WFI RK_ASM volatile("WFI" :: : "memory");
 #define RK_DIS_IRQ RK_ASM volatile("CPSID I" :: : "memory");
 #define RK_EN_IRQ RK_ASM volatile("CPSIE I" :: : "memory");
+#define RK_CLREX RK_ASM volatile("CLREX" :: : "memory");
+
+/* Exclusive access: kStoreExcl() returns 0 on success, 1 if the reservation
+ * taken by kLoadExcl() was lost (any exception in between clears it) */
+RK_FORCE_INLINE
+static inline unsigned long kLoadExcl(volatile unsigned long *addr)
+{
+    unsigned long value;
+    RK_ASM volatile("LDREX %0, [%1]" : "=r"(value) : "r"(addr) : "memory");
+    return (value);
+}
+
+RK_FORCE_INLINE
+static inline unsigned kStoreExcl(volatile unsigned long *addr,
+                                  unsigned long value)
+{
+    unsigned failed;
+    RK_ASM volatile("STREX %0, %2, [%1]"
+                    : "=&r"(failed)
+                    : "r"(addr), "r"(value)
+                    : "memory");
+    return (failed);
+}
 
 RK_FORCE_INLINE
 static inline unsigned kEnterCR(void)
@@ -67,6 +98,7 @@ static inline void kExitCR(unsigned state)
 
 #define RK_HW_REG(addr) *((volatile unsigned long *)(addr))
 #define RK_REG_SCB_ICSR RK_HW_REG(0xE000ED04)
+#define RK_SCB_ICSR_PENDSTSET (1UL << 26)
 #define RK_REG_SYSTICK_CTRL RK_HW_REG(0xE000E010)
 #define RK_REG_SYSTICK_LOAD RK_HW_REG(0xE000E014)
 #define RK_REG_SYSTICK_VAL RK_HW_REG(0xE000E018)
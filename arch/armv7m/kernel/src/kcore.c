@@ -21,6 +21,14 @@ unsigned long RK_gSysCoreClock = SystemCoreClock;
 unsigned long RK_gSysCoreClock = RK_CONF_SYSCORECLK;
 #endif
 
+#if (RK_CONF_TICKLESS == ON)
+#define RK_SYSTICK_CTRL_ENABLE (1UL << 0)
+#define RK_SCB_ICSR_PENDSVSET (1UL << 28)
+
+/* core clock cycles per kernel tick, latched when SysTick is configured */
+static unsigned long RK_gSysTickCyclesPerTick = 0UL;
+#endif
+
 static inline unsigned kCoreSysTickConfig_(unsigned ticks)
 {
     /* CheckCore if number of ticks is valid */
@@ -36,6 +44,9 @@ static inline unsigned kCoreSysTickConfig_(unsigned ticks)
 #endif
     /* Set reload register */
     RK_REG_SYSTICK_LOAD = (ticks - 1);
+#if (RK_CONF_TICKLESS == ON)
+    RK_gSysTickCyclesPerTick = ticks;
+#endif
 
     /* Reset the SysTick counter */
     RK_REG_SYSTICK_VAL = 0;
@@ -56,6 +67,168 @@ static inline unsigned kCoreSysTickConfig_(unsigned ticks)
 }
 
 
+#if (RK_CONF_TICKLESS == ON)
+unsigned long kCoreTicklessMaxTicks(void)
+{
+    if (RK_gSysTickCyclesPerTick == 0UL)
+    {
+        return (0UL);
+    }
+    /* the stretched period must still fit the 24-bit reload */
+    return (0xFFFFFFUL / RK_gSysTickCyclesPerTick);
+}
+
+/*
+ * Runs with interrupts masked. Stretches the current SysTick period so the
+ * next interrupt lands idleTicks tick boundaries ahead, sleeps, and restores
+ * the regular period on wake-up.
+ * Returns the number of tick boundaries that went by without a SysTick
+ * interrupt. The boundary that does raise one is left pending, so
+ * kTickHandler() accounts for it as soon as interrupts are unmasked.
+ */
+unsigned long kCoreTicklessSleep(unsigned long idleTicks)
+{
+    unsigned long const cycles = RK_gSysTickCyclesPerTick;
+    unsigned long const maxTicks = kCoreTicklessMaxTicks();
+    unsigned long const ctrl = RK_REG_SYSTICK_CTRL;
+
+    if ((cycles < 2UL) || ((ctrl & RK_SYSTICK_CTRL_ENABLE) == 0UL))
+    {
+        return (0UL);
+    }
+    if (idleTicks > maxTicks)
+    {
+        idleTicks = maxTicks;
+    }
+    if (idleTicks < 2UL)
+    {
+        return (0UL);
+    }
+
+    RK_REG_SYSTICK_CTRL = (ctrl & ~RK_SYSTICK_CTRL_ENABLE);
+
+    /* a tick or a context switch is already due: nothing to stretch */
+    unsigned long const partial = RK_REG_SYSTICK_VAL;
+    if ((partial == 0UL) ||
+        ((RK_REG_SCB_ICSR &
+          (RK_SCB_ICSR_PENDSTSET | RK_SCB_ICSR_PENDSVSET)) != 0UL))
+    {
+        RK_REG_SYSTICK_CTRL = (ctrl | RK_SYSTICK_CTRL_ENABLE);
+        return (0UL);
+    }
+
+    /* what is left of this tick plus (idleTicks - 1) whole ticks */
+    unsigned long const sleepCycles = partial + ((idleTicks - 1UL) * cycles);
+    RK_REG_SYSTICK_LOAD = (sleepCycles - 1UL);
+    RK_REG_SYSTICK_VAL = 0UL;
+    RK_REG_SYSTICK_CTRL = (ctrl | RK_SYSTICK_CTRL_ENABLE);
+
+    RK_DSB
+    RK_WFI
+    RK_ISB
+
+    RK_REG_SYSTICK_CTRL = (ctrl & ~RK_SYSTICK_CTRL_ENABLE);
+
+    unsigned long elapsed = 0UL;
+    unsigned long next = 0UL;
+    unsigned long const remaining = RK_REG_SYSTICK_VAL;
+
+    if ((RK_REG_SCB_ICSR & RK_SCB_ICSR_PENDSTSET) != 0UL)
+    {
+        /* slept the whole window; the counter has reloaded since */
+        unsigned long const late = (sleepCycles - 1UL) - remaining;
+        elapsed = idleTicks - 1UL;
+        next = (late < (cycles - 2UL)) ? (cycles - late) : cycles;
+    }
+    else
+    {
+        /* woken early by another interrupt */
+        elapsed = (idleTicks - 1UL) - (remaining / cycles);
+        next = remaining % cycles;
+        if ((next < 2UL) && (elapsed < (idleTicks - 1UL)))
+        {
+            /* woke right on a tick boundary: count it here */
+            elapsed += 1UL;
+            next += cycles;
+        }
+        if (next < 2UL)
+        {
+            next = 2UL;
+        }
+    }
+
+    /* finish the current tick, then fall back to the regular period, which
+     * the counter only latches on its next reload */
+    RK_REG_SYSTICK_LOAD = (next - 1UL);
+    RK_REG_SYSTICK_VAL = 0UL;
+    RK_REG_SYSTICK_CTRL = (ctrl | RK_SYSTICK_CTRL_ENABLE);
+    RK_REG_SYSTICK_LOAD = (cycles - 1UL);
+
+    return (elapsed);
+}
+#endif
+
+#if (RK_CONF_HRTIMER == ON)
+/* LM3S6965 General-Purpose Timer 0, timer A, as a 32-bit one-shot down-counter
+ * clocked by the system clock: one count per core clock cycle */
+#define RK_REG_SYSCTL_RCGC1 RK_HW_REG(0x400FE104)
+#define RK_SYSCTL_RCGC1_TIMER0 (1UL << 16)
+#define RK_GPTM0_BASE (0x40030000UL)
+#define RK_REG_GPTM0_CFG RK_HW_REG(RK_GPTM0_BASE + 0x000UL)
+#define RK_REG_GPTM0_TAMR RK_HW_REG(RK_GPTM0_BASE + 0x004UL)
+#define RK_REG_GPTM0_CTL RK_HW_REG(RK_GPTM0_BASE + 0x00CUL)
+#define RK_REG_GPTM0_IMR RK_HW_REG(RK_GPTM0_BASE + 0x018UL)
+#define RK_REG_GPTM0_ICR RK_HW_REG(RK_GPTM0_BASE + 0x024UL)
+#define RK_REG_GPTM0_TAILR RK_HW_REG(RK_GPTM0_BASE + 0x028UL)
+#define RK_GPTM_CFG_32BIT (0x0UL)
+#define RK_GPTM_TAMR_ONESHOT (0x1UL)
+#define RK_GPTM_CTL_TAEN (1UL << 0)
+#define RK_GPTM_INT_TATO (1UL << 0)
+#define RK_CORE_TIMER0A_IRQN (19U)
+#define RK_REG_NVIC_IPR(irqn)\
+    (*((volatile unsigned char *)(0xE000E400UL + (irqn))))
+
+static void kCoreHrTimerInit_(void)
+{
+    RK_REG_SYSCTL_RCGC1 |= RK_SYSCTL_RCGC1_TIMER0;
+    /* a few cycles before the peripheral can be accessed */
+    (void)RK_REG_SYSCTL_RCGC1;
+    (void)RK_REG_SYSCTL_RCGC1;
+
+    RK_REG_GPTM0_CTL = 0UL;
+    RK_REG_GPTM0_CFG = RK_GPTM_CFG_32BIT;
+    RK_REG_GPTM0_TAMR = RK_GPTM_TAMR_ONESHOT;
+    RK_REG_GPTM0_ICR = RK_GPTM_INT_TATO;
+    RK_REG_GPTM0_IMR = RK_GPTM_INT_TATO;
+
+    /* same level as the SysTick: hrtimer expiries and ticks do not nest */
+    RK_REG_NVIC_IPR(RK_CORE_TIMER0A_IRQN) = (unsigned char)((0x06 << 4) & 0xFF);
+    RK_REG_NVIC = (1UL << RK_CORE_TIMER0A_IRQN);
+}
+
+/* fires once, cycles core clock cycles from now; a running count is
+ * replaced */
+void kCoreHrTimerArm(unsigned long cycles)
+{
+    RK_REG_GPTM0_CTL = 0UL;
+    RK_REG_GPTM0_ICR = RK_GPTM_INT_TATO;
+    RK_REG_GPTM0_TAILR = (cycles > 0UL) ? cycles : 1UL;
+    RK_REG_GPTM0_CTL = RK_GPTM_CTL_TAEN;
+}
+
+void kCoreHrTimerStop(void)
+{
+    RK_REG_GPTM0_CTL = 0UL;
+    RK_REG_GPTM0_ICR = RK_GPTM_INT_TATO;
+}
+
+void Timer0A_Handler(void)
+{
+    RK_REG_GPTM0_ICR = RK_GPTM_INT_TATO;
+    kHrTimerHandler();
+}
+#endif
+
 #define SCB_SHP          (volatile unsigned long*)(0xE000ED18)
 #define NVIC_IP          (volatile unsigned long*)(0xE000E400)
 
@@ -86,4 +259,7 @@ void kCoreInit(void)
     kCoreSetInterruptPriority_(RK_CORE_SVC_IRQN, 0x05);
     kCoreSetInterruptPriority_(RK_CORE_SYSTICK_IRQN, 0x06);
     kCoreSetInterruptPriority_(RK_CORE_PENDSV_IRQN, 0x07);
+#if (RK_CONF_HRTIMER == ON)
+    kCoreHrTimerInit_();
+#endif
 }
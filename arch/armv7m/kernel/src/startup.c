@@ -37,6 +37,7 @@ void SSI_Handler(void) __attribute__((weak, alias("Default_Handler")));
 void I2C_Handler(void) __attribute__((weak, alias("Default_Handler")));
 void PWM_Handler(void) __attribute__((weak, alias("Default_Handler")));
 void ADC_Handler(void) __attribute__((weak, alias("Default_Handler")));
+void Timer0A_Handler(void) __attribute__((weak, alias("Default_Handler")));
 /* External definitions */
 extern uint32_t _sidata;     /* Start address of the initialisation values of the .data section */
 extern uint32_t _sdata;      /* Start address of the .data section */
@@ -85,6 +86,11 @@ void (* const g_pfnVectors[])(void) =
     Default_Handler,             /* IRQ 12 */
     Default_Handler,             /* IRQ 13 */
     ADC_Handler,                 /* IRQ 14: ADC */
+    Default_Handler,             /* IRQ 15 */
+    Default_Handler,             /* IRQ 16 */
+    Default_Handler,             /* IRQ 17 */
+    Default_Handler,             /* IRQ 18 */
+    Timer0A_Handler,             /* IRQ 19: GPTM Timer 0A */
 };
 
 
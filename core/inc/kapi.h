@@ -45,7 +45,8 @@
  *                     remains 8-byte aligned.
  *
  *
- * @param priority     Task priority - valid range: 0-31.(0 is highest).
+ * @param priority     Task priority - valid range: 0-RK_CONF_MIN_PRIO
+ *                     (31 by default). 0 is highest.
  *                     Priority 0 is legal for application tasks, but it is
  *                     also used by PostProcSysTask. Equal-priority readiness
  *                     does not preempt the running task, so long-running
@@ -84,6 +85,8 @@ RK_ERR kTaskInit(RK_TASK_HANDLE *taskHandlePtr, const RK_TASKENTRY taskFunc,
  * @brief Spawn a runtime task using the shared task pool and a user-selected
  *        stack partition.
  *        The spawned task stack size is the partition block size (in words).
+ *        With RK_CONF_HEAP, leave stackMemPtr NULL to take a stack of
+ *        stackSize words from stackHeapPtr instead.
  *        Controlled by RK_CONF_DYNAMIC_TASK in kconfig.h.
  * @param taskAttrPtr Pointer to dynamic task attributes.
  * @param taskHandlePtr Receives task handle.
@@ -96,7 +99,8 @@ RK_ERR kTaskInit(RK_TASK_HANDLE *taskHandlePtr, const RK_TASKENTRY taskFunc,
  *                                              partition block geometry.
  *                  RK_ERR_INVALID_PRIO       Priority is out of range.
  *                  RK_ERR_INVALID_OBJ        `stackMemPtr` is not a valid
- *                                              initialised memory partition.
+ *                                              initialised memory partition
+ *                                              (or `stackHeapPtr` a heap).
  *                  RK_ERR_TASK_POOL_EMPTY    No free stack block in partition
  *                                              or no free TCB in task pool.
  *                  RK_ERR_ERROR              Internal failure creating the task.
@@ -240,6 +244,70 @@ RK_ERR kTaskGetName(RK_TASK_HANDLE taskHandle, CHAR *buf);
  */
 RK_PRIO kTaskGetPrio(RK_TASK_HANDLE taskHandle);
 
+#if (RK_CONF_TIME_SLICE == ON)
+/**
+ * @brief  Sets the round-robin time-slice of a task.
+ *         When the slice is exhausted and another task with the same
+ *         priority is READY, the running task goes to the tail of its
+ *         ready queue. Tasks start with RK_CONF_TIME_SLICE_TICKS.
+ * @param  taskHandle Target task handle.
+ * @param  ticks      Time-slice in ticks. 0 disables slicing for the task.
+ * @return RK_ERR_SUCCESS, RK_ERR_OBJ_NULL, RK_ERR_OBJ_NOT_INIT or
+ *         RK_ERR_INVALID_PARAM (ticks > RK_MAX_PERIOD).
+ */
+RK_ERR kTaskSetTimeSlice(RK_TASK_HANDLE const taskHandle, RK_TICK const ticks);
+#endif
+
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+/**
+ * @brief  Sets the preemption threshold of a task.
+ *         While the task runs, only READY tasks with a higher priority than
+ *         the threshold preempt it. A task starts with the threshold at its
+ *         own priority, i.e., ordinary preemptive behaviour.
+ * @param  taskHandle Target task handle.
+ * @param  threshold  Threshold priority, from 0 up to the task nominal
+ *                    priority.
+ * @return RK_ERR_SUCCESS, RK_ERR_OBJ_NULL, RK_ERR_OBJ_NOT_INIT or
+ *         RK_ERR_INVALID_PRIO (threshold numerically greater than the
+ *         task nominal priority).
+ */
+RK_ERR kTaskSetPreemptThreshold(RK_TASK_HANDLE const taskHandle,
+                                RK_PRIO const threshold);
+#endif
+
+#if (RK_CONF_CPU_BUDGET == ON)
+/**
+ * @brief  Sets the CPU budget of a task.
+ *         Every tick the task is found RUNNING is charged to its budget.
+ *         When it runs out the task drops to bgPrio, and it is given its
+ *         budget back one period after it started consuming it.
+ * @param  taskHandle Target task handle.
+ * @param  budget     Ticks of execution per period. 0 removes the budget.
+ * @param  period     Replenishment period in ticks (>= budget).
+ * @param  bgPrio     Priority while the budget is exhausted, from the task
+ *                    nominal priority down to RK_CONF_MIN_PRIO.
+ * @return RK_ERR_SUCCESS, RK_ERR_OBJ_NULL, RK_ERR_OBJ_NOT_INIT,
+ *         RK_ERR_INVALID_PARAM or RK_ERR_INVALID_PRIO.
+ */
+RK_ERR kTaskSetBudget(RK_TASK_HANDLE const taskHandle, RK_TICK const budget,
+                      RK_TICK const period, RK_PRIO const bgPrio);
+#endif
+
+#if (RK_CONF_EDF == ON)
+/**
+ * @brief  Sets the relative deadline of a task.
+ *         Among READY tasks at priority RK_CONF_EDF_PRIO, the one with the
+ *         earliest absolute deadline runs. The current job deadline becomes
+ *         now + ticks; each kSleepRelease()/kSleepUntil() sets the next one
+ *         from the release time.
+ * @param  taskHandle Target task handle.
+ * @param  ticks      Relative deadline in ticks. 0 removes the deadline.
+ * @return RK_ERR_SUCCESS, RK_ERR_OBJ_NULL, RK_ERR_OBJ_NOT_INIT or
+ *         RK_ERR_INVALID_PARAM (ticks > RK_MAX_PERIOD).
+ */
+RK_ERR kTaskSetDeadline(RK_TASK_HANDLE const taskHandle, RK_TICK const ticks);
+#endif
+
 /******************************************************************************/
 /*PREEMPT DISABLE/ENABLE*/
 /******************************************************************************/
@@ -948,6 +1016,21 @@ RK_ERR kMesgPoolInit(RK_MEM_PARTITION *const poolPtr,
                      ULONG const nMesg,
                      RK_PRIO const ceilingPrio);
 
+#if (RK_CONF_HEAP == ON)
+/**
+ * @brief kMesgPoolInit() with the backing storage taken from a heap. The
+ *        storage is not given back.
+ * @param heapPtr Heap to take nMesg message blocks from.
+ * @return        As kMesgPoolInit(); RK_ERR_OBJ_NULL, or RK_ERR_MEM_INIT
+ *                if the heap cannot supply the storage.
+ */
+RK_ERR kMesgPoolInitFromHeap(RK_MEM_PARTITION *const poolPtr,
+                             RK_HEAP *const heapPtr,
+                             ULONG const payloadBytes,
+                             ULONG const nMesg,
+                             RK_PRIO const ceilingPrio);
+#endif
+
 /**
  * @brief Allocate one message from a direct-message pool.
  * @param poolPtr      Message pool initialised with kMesgPoolInit().
@@ -1579,6 +1662,124 @@ RK_ERR kMRMUnget(RK_MRM *const kobj, RK_MRM_BUF *const bufPtr);
 
 #endif
 
+#if (RK_CONF_SCHED_TABLE == ON)
+/******************************************************************************/
+/* SCHEDULE TABLE                                                             */
+/******************************************************************************/
+/**
+ * @brief Initialises a schedule table. The table repeats every duration
+ *        ticks; on each cycle, every expiry point fires at its offset from
+ *        the cycle start, from the tick handler:
+ *        RK_SCHTBL_ACT_EVENT  kEventSet(objPtr, flags)
+ *        RK_SCHTBL_ACT_SEMA   kSemaphorePost(objPtr)
+ *        RK_SCHTBL_ACT_MESGQ  kMesgQueueSend(objPtr, sendPtr, RK_NO_WAIT)
+ *        The table is created stopped.
+ * @param kobj     Schedule Table address
+ * @param epArray  Expiry points, by non-decreasing offset. Not copied; must
+ *                 outlive the table.
+ * @param nEp      Number of expiry points (> 0)
+ * @param duration Table period in ticks; every offset must be below it.
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_DOUBLE_INIT
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kSchTblInit(RK_SCHTBL *const kobj, RK_SCHTBL_EP const *const epArray,
+                   ULONG const nEp, RK_TICK const duration);
+
+/**
+ * @brief Starts a schedule table; its first cycle begins delay ticks from
+ *        now. Starting a running table restarts it.
+ *        Expiry points fire from the tick handler: with delay 0, those at
+ *        offset 0 fire on the next tick, not within this call.
+ * @param kobj  Schedule Table address
+ * @param delay Ticks until the first cycle starts.
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_NOT_INIT
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kSchTblStart(RK_SCHTBL *const kobj, RK_TICK const delay);
+
+/**
+ * @brief Stops a schedule table. No-op if it is not running.
+ * @param kobj  Schedule Table address
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_NOT_INIT
+ */
+RK_ERR kSchTblStop(RK_SCHTBL *const kobj);
+#endif
+
+#if (RK_CONF_HRTIMER == ON)
+/******************************************************************************/
+/* HIGH-RESOLUTION TIMER                                                      */
+/******************************************************************************/
+/**
+ * @brief Initialises a high-resolution one-shot timer. It is created
+ *        disarmed; kHrTimerStart() arms it.
+ * @param kobj    High-resolution Timer address
+ * @param funPtr  Callout Function at expiry. Runs in ISR context.
+ * @param argsPtr Generic pointer to callout arguments
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_DOUBLE_INIT
+ */
+RK_ERR kHrTimerInit(RK_HRTIMER *const kobj, RK_TIMER_CALLOUT const funPtr,
+                    VOID *const argsPtr);
+
+/**
+ * @brief Arms a high-resolution timer to expire us microseconds from now.
+ *        An armed timer is re-armed. Can be called from an ISR, including
+ *        from a callout.
+ * @param kobj High-resolution Timer address
+ * @param us   Delay in microseconds, from 1 up to 2^31 core clock cycles.
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_NOT_INIT
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kHrTimerStart(RK_HRTIMER *const kobj, ULONG const us);
+
+/**
+ * @brief Disarms a high-resolution timer. No-op if it is not armed.
+ * @param kobj High-resolution Timer address
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_NOT_INIT
+ */
+RK_ERR kHrTimerCancel(RK_HRTIMER *const kobj);
+
+/**
+ * @brief       Put the current task to sleep for a number of microseconds,
+ *              on the high-resolution timer instead of the tick.
+ *              Task switches to SLEEPING state.
+ *              As kSleepDelay(), this is a relative delay.
+ * @param us    Microseconds to sleep, up to 2^31 core clock cycles.
+ * @return      Successful:
+ *                                   RK_ERR_SUCCESS
+ *                   Unsuccessful:
+ *                                   RK_ERR_TIMEOUT (us is 0)
+ *                   Errors:
+ *                                   RK_ERR_INVALID_ISR_PRIMITIVE
+ *                                   RK_ERR_TASK_INVALID_ST
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kSleepUs(ULONG const us);
+#endif
+
 #if (RK_CONF_CALLOUT_TIMER == ON)
 /******************************************************************************/
 /* APPLICATION TIMER                                                          */
@@ -1594,6 +1795,8 @@ RK_ERR kMRMUnget(RK_MRM *const kobj, RK_MRM_BUF *const bufPtr);
  * @param argsPtr Generic pointer to callout arguments
  * @param reload RK_TIMER_RELOAD for reloading after timer-out.
  *               RK_TIMER_ONESHOT for an one-shot
+ *               With RK_CONF_FAST_TIMER, OR RK_TIMER_FAST in to run the
+ *               callout from the tick handler (ISR context).
 
  * @return       Successful:
  *                                   RK_ERR_SUCCESS
@@ -1605,6 +1808,29 @@ RK_ERR kMRMUnget(RK_MRM *const kobj, RK_MRM_BUF *const bufPtr);
 RK_ERR kTimerInit(RK_TIMER *const kobj, const RK_TICK phase,
                   const RK_TICK countTicks, const RK_TIMER_CALLOUT funPtr,
                   VOID *argsPtr, const RK_OPTION reload);
+#if (RK_CONF_TIMER_EVENT == ON)
+/**
+ * @brief Initialises and arms a timer that sets event flags of a task at
+ *        expiry, instead of running a callout. The flags are set from the
+ *        tick handler.
+ * @param kobj  Timer Object address
+ * @param phase Initial phase delay; does not apply to reloads.
+ * @param countTicks Period/expiry delay in ticks. Must be non-zero.
+ * @param taskHandle Task to signal.
+ * @param flags Event flags to set. Must be non-zero.
+ * @param reload RK_TIMER_RELOAD or RK_TIMER_ONESHOT
+ * @return       Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_DOUBLE_INIT
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kTimerInitEvent(RK_TIMER *const kobj, RK_TICK const phase,
+                       RK_TICK const countTicks,
+                       RK_TASK_HANDLE const taskHandle,
+                       RK_TASK_EVENT const flags, RK_OPTION const reload);
+#endif
 #if (RK_CONF_DYNAMIC_OBJECTS == ON)
 RK_ERR kTimerCreate(RK_TIMER_HANDLE *const timerHandlePtr,
                     RK_TICK const phase,
@@ -1626,6 +1852,25 @@ RK_ERR kTimerDestroy(RK_TIMER_HANDLE *const timerHandlePtr);
  *                                   RK_ERR_ERROR
  */
 RK_ERR kTimerCancel(RK_TIMER *const kobj);
+
+#if (RK_CONF_TIMER_SLACK == ON)
+/**
+ * @brief       Sets how late a timer is allowed to fire, so its expiries can
+ *              be merged with those of other timers. A pending expiry is
+ *              re-armed under the new slack. Reload timers keep their
+ *              nominal period; slack does not accumulate.
+ * @param kobj  Timer object address
+ * @param slack Tolerated lateness in ticks, below the timer period.
+ *              0 restores exact expiries.
+ * @return      Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_INVALID_OBJ
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kTimerSetSlack(RK_TIMER *const kobj, RK_TICK const slack);
+#endif
 #endif
 
 /******************************************************************************/
@@ -1728,6 +1973,14 @@ RK_ERR kSleepUntil(RK_TICK *lastTickPtr, RK_TICK const period);
  */
 RK_TICK kTickGet(VOID);
 
+/**
+ * @brief Gets the number of ticks since the scheduler started, on 64 bits:
+ *        it does not wrap around. Does not disable interrupts; the read is
+ *        retried if a tick is accounted meanwhile. Callable from ISRs.
+ * @return Global system tick value, wrap-free
+ */
+ULLONG kTickGet64(VOID);
+
 /**
  * @brief Gets the current number of ticks
  *        in milliseconds
@@ -1735,6 +1988,24 @@ RK_TICK kTickGet(VOID);
  */
 RK_TICK kTickGetMs(VOID);
 
+/**
+ * @brief Gets a microsecond timestamp: the tick count plus the part of the
+ *        current tick gone by, from the SysTick counter. Does not disable
+ *        interrupts, and is callable from ISRs.
+ *        Wraps around modulo 2^32 (~71 minutes): take differences of two
+ *        readings.
+ * @return Microseconds since the scheduler started.
+ */
+ULONG kTickGetUs(VOID);
+
+/**
+ * @brief Gets a core clock cycle timestamp, on the same time base as
+ *        kTickGetUs(). Wraps around modulo 2^32: take differences of two
+ *        readings less than 2^32 cycles apart.
+ * @return Core clock cycles since the scheduler started.
+ */
+ULONG kTickGetCycles(VOID);
+
 /**
  * @brief   Active wait for a number of ticks. Task is not suspended.
  *          Counts only ticks observed while the caller is running; time
@@ -1779,6 +2050,18 @@ RK_ERR kMemPartitionInit(RK_MEM_PARTITION *const kobj, VOID *memPoolPtr,
  */
 VOID *kMemPartitionAlloc(RK_MEM_PARTITION *const kobj);
 
+/**
+ * @brief Allocate a block from a pool, waiting for one to be freed if it is
+ *        empty. A freed block is handed straight to the highest-priority
+ *        waiter. Not for message pools (kMesgAlloc()).
+ * @param kobj    Pointer to the partition pool
+ * @param timeout Suspension time-out in ticks, RK_NO_WAIT or
+ *                RK_WAIT_FOREVER. Only RK_NO_WAIT from an ISR.
+ * @return Address of a memory block, or NULL on time-out or failure
+ */
+VOID *kMemPartitionAllocWait(RK_MEM_PARTITION *const kobj,
+                             RK_TICK const timeout);
+
 /**
  * @brief Free a memory block (Returns it to the pool)
  * @param kobj Pointer to the partition pool
@@ -1796,6 +2079,129 @@ VOID *kMemPartitionAlloc(RK_MEM_PARTITION *const kobj);
  */
 RK_ERR kMemPartitionFree(RK_MEM_PARTITION *const kobj, VOID *blockPtr);
 
+/**
+ * @brief Attach an allocation map to a pool, so kMemPartitionFree() checks
+ *        for invalid and double frees in constant time instead of walking
+ *        the free list. Only used when RK_CONF_ERR_CHECK is ON.
+ *        Call it right after kMemPartitionInit(), before any allocation.
+ * @param kobj   Pointer to the partition pool
+ * @param mapPtr Map storage (typically declared with
+ *               RK_DECLARE_MEM_POOL_MAP()).
+ * @param nWords Number of words in the map; at least
+ *               RK_MEM_POOL_MAP_WORDS(numBlocks).
+ * @return                  Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_INVALID_OBJ
+ *                                   RK_ERR_OBJ_NOT_INIT
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kMemPartitionAttachMap(RK_MEM_PARTITION *const kobj,
+                              ULONG *const mapPtr, ULONG const nWords);
+#ifndef RK_DECLARE_MEM_POOL_MAP
+#define RK_DECLARE_MEM_POOL_MAP(BUFNAME, N_BLOCKS)                             \
+    ULONG BUFNAME[RK_MEM_POOL_MAP_WORDS(N_BLOCKS)] K_ALIGN(4);
+#endif
+
+#if (RK_CONF_MEM_ALLOC == ON)
+/**
+ * @brief Allocates a block of at least bytes from the size-class allocator:
+ *        the smallest power-of-2 class that fits, or a larger one if it is
+ *        drained. Constant time; callable from ISRs.
+ * @param bytes Requested size, up to the largest class.
+ * @return Address of a word-aligned block, or NULL on failure
+ */
+VOID *kMemAlloc(ULONG const bytes);
+
+/**
+ * @brief Returns a block taken with kMemAlloc(). Its class is found from the
+ *        address.
+ * @param blockPtr Address returned by kMemAlloc()
+ * @return              Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Unsuccessful:
+ *                                   RK_ERR_MEM_FREE       Not a kMemAlloc()
+ *                                                         block, or double
+ *                                                         free.
+ */
+RK_ERR kMemFree(VOID *const blockPtr);
+#endif
+
+/******************************************************************************/
+/* VARIABLE-SIZE HEAP                                                         */
+/******************************************************************************/
+#if (RK_CONF_HEAP == ON)
+/**
+ * @brief Initialise a heap over a memory region. Blocks of any size are
+ *        taken and returned in constant time (two-level segregated fit).
+ *        Registered with the trace object registry.
+ * @param kobj   Pointer to a heap control block
+ * @param memPtr Backing storage (typically declared with
+ *               RK_DECLARE_HEAP_POOL()).
+ * @param bytes  Size of the region; at most 2^RK_CONF_HEAP_MAX_SHIFT.
+ *               Each block costs an 8-byte header (2 words).
+ * @return                  Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_OBJ_DOUBLE_INIT
+ *                                   RK_ERR_INVALID_PARAM
+ */
+RK_ERR kHeapInit(RK_HEAP *const kobj, VOID *const memPtr, ULONG const bytes);
+#ifndef RK_DECLARE_HEAP_POOL
+#define RK_DECLARE_HEAP_POOL(BUFNAME, N_BYTES)                                 \
+    ULONG BUFNAME[((N_BYTES) + RK_WORD_SIZE - 1UL) / RK_WORD_SIZE] K_ALIGN(8);
+#endif
+
+/**
+ * @brief Allocate a block from a heap. Constant time; callable from ISRs.
+ * @param kobj  Pointer to the heap
+ * @param bytes Requested size in bytes
+ * @return Address of an 8-byte aligned block, or NULL on failure
+ */
+VOID *kHeapAlloc(RK_HEAP *const kobj, ULONG const bytes);
+
+/**
+ * @brief Return a block to its heap, merging it with free neighbours.
+ * @param kobj Pointer to the heap
+ * @param ptr  Address returned by kHeapAlloc() or kHeapRealloc()
+ * @return              Successful:
+ *                                   RK_ERR_SUCCESS
+ *                      Unsuccessful:
+ *                                   RK_ERR_MEM_FREE       Not a block of this
+ *                                                         heap, or double
+ *                                                         free.
+ *                      Errors:
+ *                                   RK_ERR_OBJ_NULL
+ *                                   RK_ERR_INVALID_OBJ
+ *                                   RK_ERR_OBJ_NOT_INIT
+ */
+RK_ERR kHeapFree(RK_HEAP *const kobj, VOID *const ptr);
+
+/**
+ * @brief Resize a block. It grows in place into a free successor when it
+ *        can; otherwise the contents move to a new block, copied with
+ *        interrupts enabled between two constant-time critical sections.
+ *        ptr NULL is kHeapAlloc(); bytes 0 is kHeapFree().
+ * @param kobj  Pointer to the heap
+ * @param ptr   Block to resize
+ * @param bytes New size in bytes
+ * @return Address of the resized block, or NULL on failure (ptr is then
+ *         left untouched)
+ */
+VOID *kHeapRealloc(RK_HEAP *const kobj, VOID *const ptr, ULONG const bytes);
+
+/**
+ * @brief Read the usage counters of a heap.
+ * @param kobj     Pointer to the heap
+ * @param statsPtr Receives the counters (see RK_HEAP_STATS)
+ * @return RK_ERR_SUCCESS, RK_ERR_OBJ_NULL, RK_ERR_INVALID_OBJ or
+ *         RK_ERR_OBJ_NOT_INIT
+ */
+RK_ERR kHeapGetStats(RK_HEAP *const kobj, RK_HEAP_STATS *const statsPtr);
+#endif
+
 /******************************************************************************/
 /* MISC/HELPERS                                                               */
 /******************************************************************************/
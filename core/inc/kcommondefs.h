@@ -97,6 +97,9 @@ typedef struct RK_STRUCT_LIST RK_LIST;
 typedef struct RK_STRUCT_LIST_EXT RK_LIST_EXT;
 typedef struct RK_STRUCT_LIST_NODE RK_NODE;
 typedef RK_LIST RK_TCBQ;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+typedef struct RK_STRUCT_PRIO_INDEX RK_PRIO_INDEX;
+#endif
 
 /* Pointer to TCB is a Task Handle */
 typedef struct RK_OBJ_TCB* RK_TASK_HANDLE;
@@ -121,6 +124,21 @@ typedef RK_TIMER *RK_TIMER_HANDLE;
 
 #endif
 
+#if (RK_CONF_SCHED_TABLE == ON)
+typedef struct RK_OBJ_SCHTBL RK_SCHTBL;
+typedef struct RK_STRUCT_SCHTBL_EP RK_SCHTBL_EP;
+#endif
+
+#if (RK_CONF_HRTIMER == ON)
+typedef struct RK_OBJ_HRTIMER RK_HRTIMER;
+#endif
+
+#if (RK_CONF_HEAP == ON)
+typedef struct RK_OBJ_HEAP RK_HEAP;
+typedef struct RK_STRUCT_HEAP_BLOCK RK_HEAP_BLOCK;
+typedef struct RK_STRUCT_HEAP_STATS RK_HEAP_STATS;
+#endif
+
 #if (RK_CONF_SLEEP_QUEUE == ON)
 typedef struct RK_OBJ_SLEEP_QUEUE RK_SLEEP_QUEUE;
 #if (RK_CONF_DYNAMIC_OBJECTS == ON)
@@ -265,11 +283,27 @@ typedef void (*RK_TIMER_CALLOUT)(void*);     /* Callout (timers)             */
 #define RK_POSTPROC_TASK_ID ((RK_TID)(0x01))
 #define RK_IDLETASK_ID ((RK_TID)(0x00))
 #define RK_N_SYSTASKS 2U /* idle + post-processing */
-#define RK_NTHREADS (RK_CONF_N_USRTASKS_MAX + RK_N_SYSTASKS)
+#if ((RK_CONF_CALLOUT_TIMER == ON) && (RK_CONF_TIMER_BANDS > 1U))
+#define RK_N_TIMER_BAND_TASKS (RK_CONF_TIMER_BANDS - 1U)
+#else
+#define RK_N_TIMER_BAND_TASKS 0U
+#endif
+#define RK_NTHREADS \
+    (RK_CONF_N_USRTASKS_MAX + RK_N_SYSTASKS + RK_N_TIMER_BAND_TASKS)
 #define RK_CONF_NTASKS RK_NTHREADS
 #ifndef RK_RDYQSIZ
 #define RK_RDYQSIZ (RK_CONF_MIN_PRIO + RK_N_SYSTASKS)
 #endif
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+#define RK_PRIO_INDEX_WORDS ((RK_RDYQSIZ + 31U) / 32U)
+#endif
+#if (RK_CONF_PRIO_CONTRIB == ON)
+#define RK_PRIO_CONTRIB_WORDS ((RK_RDYQSIZ + 31U) / 32U)
+#endif
+/* more than 32 priority levels are tracked by a two-level ready bitmap */
+#if (RK_CONF_MIN_PRIO > 31)
+#define RK_READY_BITMAP_GROUPS ((RK_RDYQSIZ + 31U) / 32U)
+#endif
 
 /*** SERVICE TOKENS  ***/
 /* Blocking option */
@@ -301,6 +335,14 @@ typedef void (*RK_TIMER_CALLOUT)(void*);     /* Callout (timers)             */
 #define RK_TIMER_ONESHOT (RK_OPTION)(0U)
 #define RK_OPT_TIMER_RELOAD RK_TIMER_RELOAD
 #define RK_OPT_TIMER_ONESHOT RK_TIMER_ONESHOT
+/* OR-ed with the above: callout runs from the tick handler */
+#define RK_TIMER_FAST (RK_OPTION)(2U)
+#define RK_OPT_TIMER_FAST RK_TIMER_FAST
+
+/* schedule table expiry point actions */
+#define RK_SCHTBL_ACT_EVENT (UINT)(1U) /* kEventSet(task, flags)          */
+#define RK_SCHTBL_ACT_SEMA (UINT)(2U)  /* kSemaphorePost(semaphore)       */
+#define RK_SCHTBL_ACT_MESGQ (UINT)(3U) /* kMesgQueueSend(queue, mesg, 0) */
 
 /* TIMEOUT CODES */
 /* elapsed bounded waiting on a public event object */
@@ -530,8 +572,11 @@ typedef void (*RK_TIMER_CALLOUT)(void*);     /* Callout (timers)             */
 #define RK_ASR_KOBJ_ID ((RK_ID)0xD01FFF03) /* legacy placeholder */
 #define RK_MRM_KOBJ_ID ((RK_ID)0xD01FFF02)
 #define RK_TIMER_KOBJ_ID ((RK_ID)0xD02FFF01)
+#define RK_SCHTBL_KOBJ_ID ((RK_ID)0xD02FFF02)
+#define RK_HRTIMER_KOBJ_ID ((RK_ID)0xD02FFF03)
 
 #define RK_MEMALLOC_KOBJ_ID ((RK_ID)0xD04FFF01)
+#define RK_HEAP_KOBJ_ID ((RK_ID)0xD04FFF02)
 
 #define RK_TASKHANDLE_KOBJ_ID ((RK_ID)0xD08FFF01)
 
@@ -625,6 +670,22 @@ typedef void (*RK_TIMER_CALLOUT)(void*);     /* Callout (timers)             */
         ((UINT)(((sizeof(TYPE) + RK_WORD_SIZE - 1UL)) / RK_WORD_SIZE))
 #endif
 
+/* words of a one-bit-per-block allocation map for N_BLOCKS blocks */
+#ifndef RK_MEM_POOL_MAP_WORDS
+#define RK_MEM_POOL_MAP_WORDS(N_BLOCKS)\
+        (((ULONG)(N_BLOCKS) + 31UL) / 32UL)
+#endif
+
+/* heap geometry: 8-byte blocks; 8 second-level lists per power of 2; sizes
+ * below 2^RK_HEAP_FL_SHIFT share first level 0, in 8-byte steps */
+#if (RK_CONF_HEAP == ON)
+#define RK_HEAP_ALIGN_SHIFT (3UL)
+#define RK_HEAP_SL_SHIFT (3UL)
+#define RK_HEAP_FL_SHIFT (RK_HEAP_SL_SHIFT + RK_HEAP_ALIGN_SHIFT)
+#define RK_HEAP_FL_COUNT (RK_CONF_HEAP_MAX_SHIFT - RK_HEAP_FL_SHIFT + 1UL)
+#define RK_HEAP_SL_COUNT (1UL << RK_HEAP_SL_SHIFT)
+#endif
+
 /* round a number of words to the next power of 2 up to 16 */
 #ifndef RK_ROUND_POW2_1_2_4_8_16
 #define RK_ROUND_POW2_1_2_4_8_16(W)\
@@ -175,6 +175,33 @@ account.
 #define RK_CONF_N_USRTASKS_MAX (31)
 #endif
 
+/***[ PRIORITY LEVELS ********************************************************/
+/* Lowest (numerically highest) priority a user task can have; 0 is the       */
+/* highest. Up to 31, ready queues are tracked by a single 32-bit bitmap.     */
+/* Above it, a two-level bitmap (a group mask plus one 32-bit mask per group  */
+/* of 32 priorities) keeps picking the next task O(1).                        */
+/* (!) Maximum is 253, as RK_PRIO is a byte and the Idle Task takes the level */
+/*     below RK_CONF_MIN_PRIO.                                                */
+#ifndef RK_CONF_MIN_PRIO
+#define RK_CONF_MIN_PRIO (31)
+#endif
+
+/***[ EARLIEST-DEADLINE-FIRST BAND *******************************************/
+/* When ON, the READY tasks at priority RK_CONF_EDF_PRIO are kept ordered by  */
+/* absolute deadline instead of FIFO, and one of them with an earlier         */
+/* deadline preempts another. Priorities above and below the band stay fixed. */
+/* A task gets a relative deadline with kTaskSetDeadline(); every            */
+/* kSleepRelease() or kSleepUntil() then sets the next absolute deadline as   */
+/* release time + relative deadline. Tasks with no deadline go last.          */
+#ifndef RK_CONF_EDF
+#define RK_CONF_EDF (OFF)
+#endif
+#if (RK_CONF_EDF == ON)
+#ifndef RK_CONF_EDF_PRIO
+#define RK_CONF_EDF_PRIO (RK_CONF_MIN_PRIO / 2)
+#endif
+#endif
+
 /***[ SYSTEM CORE CLOCK  *****************************************************/
 /* If using CMSIS-Core HAL you can set this value to 0, so it will fallback   */
 /* to CMSIS SystemCoreClock. (Not valid for QEMU buildings).                  */
@@ -190,6 +217,55 @@ account.
 #ifndef RK_CONF_SYSTICK_DIV
 #define RK_CONF_SYSTICK_DIV (100UL)
 #endif
+/***[ ROUND-ROBIN TIME SLICING ***********************************************/
+/* When ON, a RUNNING task that exhausts its time-slice is moved to the tail  */
+/* of its ready queue if another task of the same priority is READY.          */
+/* Every task starts with RK_CONF_TIME_SLICE_TICKS, that can be changed per   */
+/* task with kTaskSetTimeSlice(). A time-slice of 0 disables it for a task.   */
+/* Non-preemptible tasks and a locked scheduler are never sliced.             */
+#ifndef RK_CONF_TIME_SLICE
+#define RK_CONF_TIME_SLICE (OFF)
+#endif
+#if (RK_CONF_TIME_SLICE == ON)
+#ifndef RK_CONF_TIME_SLICE_TICKS
+#define RK_CONF_TIME_SLICE_TICKS (5UL)
+#endif
+#endif
+/***[ PREEMPTION THRESHOLD ***************************************************/
+/* When ON, a task may raise its preemption threshold above its priority with */
+/* kTaskSetPreemptThreshold(). While it runs, only tasks of higher priority   */
+/* than the threshold preempt it; tasks in between wait until it blocks or    */
+/* yields. A task starts with its threshold at its own priority.              */
+#ifndef RK_CONF_PREEMPT_THRESHOLD
+#define RK_CONF_PREEMPT_THRESHOLD (OFF)
+#endif
+/***[ CPU BUDGET *************************************************************/
+/* When ON, kTaskSetBudget() gives a task an execution budget per            */
+/* replenishment period. Each tick the task is found RUNNING is charged to   */
+/* its budget; once it is exhausted the task runs at its background priority */
+/* until the budget is replenished, one period after it started being        */
+/* consumed (single-chunk sporadic server). Inheritance and ceiling boosts   */
+/* still apply to an exhausted task.                                         */
+#ifndef RK_CONF_CPU_BUDGET
+#define RK_CONF_CPU_BUDGET (OFF)
+#endif
+/***[ TICKLESS IDLE ***********************************************************/
+/* When ON, the Idle Task stretches the SysTick period up to the earliest     */
+/* armed expiry on the time-out and timer lists and sleeps (WFI) until then,  */
+/* or until any other interrupt wakes the core. The ticks that went by        */
+/* without a SysTick interrupt are charged to the run time and to the         */
+/* delta-lists in one step on wake-up.                                        */
+/* RK_CONF_TICKLESS_MIN_TICKS is the shortest idle window worth reprogramming */
+/* the SysTick for. Below it the Idle Task sleeps tick by tick as usual.      */
+/* (!) Per-tick trace sampling does not run while the tick is stretched.      */
+#ifndef RK_CONF_TICKLESS
+#define RK_CONF_TICKLESS (OFF)
+#endif
+#if (RK_CONF_TICKLESS == ON)
+#ifndef RK_CONF_TICKLESS_MIN_TICKS
+#define RK_CONF_TICKLESS_MIN_TICKS (2UL)
+#endif
+#endif
 /***[ MILLISEC TO TICK GRANULARITY ********************************************/
 /* This setting defines if asking to convert a time value in milliseconds that
  * is less than 1 TICK it rounds up to 1 or returns 0
@@ -211,6 +287,110 @@ account.
 #endif
 #endif
 
+/* TIMER SLACK */
+/* When ON, kTimerSetSlack() lets a timer fire up to 'slack' ticks late. On  */
+/* each arming the expiry is moved onto that of an armed timer inside the    */
+/* window, or else onto a grid of the largest power of 2 within the slack,   */
+/* so loosely timed timers are handled in a single post-processing pass.     */
+#ifndef RK_CONF_TIMER_SLACK
+#define RK_CONF_TIMER_SLACK (OFF)
+#endif
+
+/* FAST TIMERS */
+/* When ON, a timer initialised with RK_TIMER_FAST OR-ed into its reload    */
+/* option runs its callout and reload straight from the tick handler, with  */
+/* no switch to the Post-Processing System Task.                            */
+/* (!) The callout runs in ISR context: keep it short and use only services */
+/* that are safe from an ISR (kEventSet(), kSemaphorePost(),                */
+/* kMesgQueueSend() with RK_NO_WAIT, ...).                                  */
+#ifndef RK_CONF_FAST_TIMER
+#define RK_CONF_FAST_TIMER (OFF)
+#endif
+
+/* EVENT TIMERS */
+/* When ON, kTimerInitEvent() binds a timer to a task and a set of event     */
+/* flags instead of a callout. At expiry the flags are set from the tick     */
+/* handler; the Post-Processing System Task is not involved.                 */
+#ifndef RK_CONF_TIMER_EVENT
+#define RK_CONF_TIMER_EVENT (OFF)
+#endif
+
+/* TIMER SERVICE BANDS */
+/* Number of timer service bands, each with its own expiry list and service  */
+/* task. Band 0 is served by the Post-Processing System Task; band n > 0 by  */
+/* a preemptible task at priority RK_CONF_TIMER_BAND_PRIO + n - 1, with a    */
+/* stack of RK_CONF_TIMER_BAND_STACKSIZE words. kTimerSetBand() moves a      */
+/* timer off band 0, so slow callouts do not delay critical ones.            */
+/* 1 keeps every callout in the Post-Processing System Task.                 */
+#ifndef RK_CONF_TIMER_BANDS
+#define RK_CONF_TIMER_BANDS (1U)
+#endif
+#if (RK_CONF_TIMER_BANDS > 1U)
+#ifndef RK_CONF_TIMER_BAND_PRIO
+#define RK_CONF_TIMER_BAND_PRIO (1U)
+#endif
+#ifndef RK_CONF_TIMER_BAND_STACKSIZE
+#define RK_CONF_TIMER_BAND_STACKSIZE (256) /* Words */
+#endif
+#endif
+
+/* SCHEDULE TABLES */
+/* When ON, RK_SCHTBL objects hold a cyclic list of expiry points (offset    */
+/* into the table period + action). Running tables are dispatched straight   */
+/* from the tick handler, with no timer callout or post-processing task      */
+/* switch, for jitter-free tick-aligned releases.                            */
+#ifndef RK_CONF_SCHED_TABLE
+#define RK_CONF_SCHED_TABLE (OFF)
+#endif
+
+/* TIMING WHEEL */
+/* When ON, armed time-outs and timers are kept on a hashed timing wheel     */
+/* (one slot list per tick modulo RK_CONF_TIMING_WHEEL_SLOTS) instead of the */
+/* delta-lists: arming and cancelling are O(1) with interrupts disabled. A   */
+/* tick only visits the nodes hashed onto its own slot. Choose a number of   */
+/* slots (power of 2) at or above the usual time-out/period length.          */
+/* (!) A tickless idle window is bounded by the next non-empty slot.         */
+#ifndef RK_CONF_TIMING_WHEEL
+#define RK_CONF_TIMING_WHEEL (OFF)
+#endif
+#if (RK_CONF_TIMING_WHEEL == ON)
+#ifndef RK_CONF_TIMING_WHEEL_SLOTS
+#define RK_CONF_TIMING_WHEEL_SLOTS (64UL)
+#endif
+#endif
+
+/* ABSOLUTE TIME-OUT TICKS */
+/* When ON, nodes on the time-out and timer lists hold their absolute expiry */
+/* tick (wrap-safe) instead of a delta to their predecessor. A tick compares */
+/* the list heads against the global tick and decrements nothing, and the    */
+/* remaining time of any armed node is a single subtraction.                 */
+/* (!) Not to be combined with RK_CONF_TIMING_WHEEL, that already keeps      */
+/* absolute expiry ticks.                                                    */
+#ifndef RK_CONF_ABS_TIMEOUT
+#define RK_CONF_ABS_TIMEOUT (OFF)
+#endif
+
+/* LAZY TIME-OUT ARMING */
+/* When ON, a bounded wait (other than a sleep) only records its time-out    */
+/* and parks the node on a short pending list. The node is armed on the      */
+/* time-out list at the next tick boundary if the task is still blocked; a   */
+/* wait satisfied before that never touches the time-out list. Time-outs are */
+/* charged from the same tick either way.                                    */
+#ifndef RK_CONF_LAZY_TIMEOUT
+#define RK_CONF_LAZY_TIMEOUT (OFF)
+#endif
+
+/* HIGH-RESOLUTION TIMERS */
+/* When ON, RK_HRTIMER objects and kSleepUs() take one-shot deadlines in     */
+/* microseconds, independent of the tick. Armed deadlines are kept sorted    */
+/* and a general-purpose hardware timer is programmed to the earliest one;   */
+/* its ISR runs the callouts and wakes the sleepers.                         */
+/* (!) Callouts run in ISR context.                                          */
+/* (!) Ported to the LM3S6965 only (GPTM Timer 0A).                          */
+#ifndef RK_CONF_HRTIMER
+#define RK_CONF_HRTIMER (OFF)
+#endif
+
 /******************************************************************************/
 /********* 3. INTER-TASK COMMUNICATION ****************************************/
 /******************************************************************************/
@@ -266,11 +446,90 @@ account.
 #define RK_CONF_SYNCH_MESG (ON)
 #endif
 
+/* DIRECTED HANDOFF */
+/* When ON, a synchronous send, call or reply that readies a task which is  */
+/* to run next switches straight to it: the task does not go through its   */
+/* ready queue and the scheduler does not search the ready bitmap for it.  */
+#if (RK_CONF_SYNCH_MESG == ON)
+#ifndef RK_CONF_SYNCH_HANDOFF
+#define RK_CONF_SYNCH_HANDOFF (OFF)
+#endif
+#endif
+
 /* MRM PROTOCOL */
 #ifndef RK_CONF_MRM
 #define RK_CONF_MRM (ON)
 #endif
 
+/*** WAITING QUEUES ***/
+
+/* PRIORITY-INDEXED WAITING QUEUES */
+/* When ON, the waiting queues of semaphores, mutexes, sleep queues, message  */
+/* queues and memory partitions keep a per-priority tail pointer and a        */
+/* bitmap of the priorities present, so a priority-ordered enqueue or a      */
+/* removal is O(1) instead of walking the queue. Each queue pays             */
+/* (RK_CONF_MIN_PRIO + 2) pointers plus the bitmap.                           */
+#ifndef RK_CONF_PRIO_WAIT_QUEUE
+#define RK_CONF_PRIO_WAIT_QUEUE (OFF)
+#endif
+
+/* INCREMENTAL EFFECTIVE PRIORITY */
+/* When ON, every task keeps a reference count per priority level for the   */
+/* boosts applied to it (inherited mutex waiters, message pool ceilings),    */
+/* plus a bitmap of the non-zero counts. Boosts are added and dropped as     */
+/* they happen, and the effective priority is read from the bitmap instead   */
+/* of walking the owned mutex and owned message lists. Each task pays       */
+/* (RK_CONF_MIN_PRIO + 2) counters plus the bitmap.                          */
+#ifndef RK_CONF_PRIO_CONTRIB
+#define RK_CONF_PRIO_CONTRIB (OFF)
+#endif
+
+/*** MEMORY ALLOCATION ***/
+
+/* LOCK-FREE PARTITIONS */
+/* When ON, kMemPartitionAlloc() and kMemPartitionFree() pop and push the    */
+/* free list with LDREX/STREX instead of masking interrupts (ARMv7-M only).  */
+/* Waking a kMemPartitionAllocWait() task and checking a free on a pool      */
+/* with no allocation map still take a critical section.                     */
+#ifndef RK_CONF_MEM_PARTITION_LOCKFREE
+#define RK_CONF_MEM_PARTITION_LOCKFREE (OFF)
+#endif
+
+/* SIZE-CLASS ALLOCATOR */
+/* When ON, kMemAlloc()/kMemFree() serve blocks of any size from a set of    */
+/* RK_CONF_MEM_ALLOC_CLASSES memory partitions of power-of-2 block sizes,    */
+/* from 2^RK_CONF_MEM_ALLOC_MIN_SHIFT bytes up. Each class takes an equal    */
+/* region of RK_CONF_MEM_ALLOC_CLASS_BYTES (power of 2) of one static arena, */
+/* so the class owning a block is found from its address alone.              */
+#ifndef RK_CONF_MEM_ALLOC
+#define RK_CONF_MEM_ALLOC (OFF)
+#endif
+#if (RK_CONF_MEM_ALLOC == ON)
+#ifndef RK_CONF_MEM_ALLOC_MIN_SHIFT
+#define RK_CONF_MEM_ALLOC_MIN_SHIFT (4UL) /* 16 bytes */
+#endif
+#ifndef RK_CONF_MEM_ALLOC_CLASSES
+#define RK_CONF_MEM_ALLOC_CLASSES (5UL) /* 16 to 256 bytes */
+#endif
+#ifndef RK_CONF_MEM_ALLOC_CLASS_BYTES
+#define RK_CONF_MEM_ALLOC_CLASS_BYTES (1024UL)
+#endif
+#endif
+
+/* VARIABLE-SIZE HEAP */
+/* When ON, RK_HEAP objects allocate blocks of any size in O(1) (two-level   */
+/* segregated fit: a bitmap lookup, no list walks). A heap can back task     */
+/* stacks (kTaskSpawn()) and message pools (kMesgPoolInitFromHeap()).        */
+/* RK_CONF_HEAP_MAX_SHIFT is log2 of the largest heap, in bytes.             */
+#ifndef RK_CONF_HEAP
+#define RK_CONF_HEAP (OFF)
+#endif
+#if (RK_CONF_HEAP == ON)
+#ifndef RK_CONF_HEAP_MAX_SHIFT
+#define RK_CONF_HEAP_MAX_SHIFT (16UL) /* 64 KiB */
+#endif
+#endif
+
 /******************************************************************************/
 /********* 4. ERROR CHECKING    ***********************************************/
 /******************************************************************************/
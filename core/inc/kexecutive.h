@@ -28,6 +28,7 @@ extern "C" {
 #include <ksch.h>
 #include <klist.h>
 #include <kmem.h>
+#include <kheap.h>
 #include <kdynobjs.h>
 #include <ktaskevents.h>
 #include <ksleepq.h>
@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/******************************************************************************/
+/**                                                                           */
+/** RK0 - The Embedded Real-Time Kernel '0'                                   */
+/** (C) 2026 Antonio Giacomelli <dev@kernel0.org>                             */
+/**                                                                           */
+/** VERSION: V0.73.0                                                          */
+/**                                                                           */
+/** You may obtain a copy of the License at :                                 */
+/** http://www.apache.org/licenses/LICENSE-2.0                                */
+/**                                                                           */
+/******************************************************************************/
+
+/******************************************************************************/
+#ifndef RK_HEAP_H
+#define RK_HEAP_H
+
+#include <kenv.h>
+#include <kcoredefs.h>
+#include <kcommondefs.h>
+#include <kobjs.h>
+#include <kstring.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (RK_CONF_HEAP == ON)
+RK_ERR kHeapInit(RK_HEAP *const, VOID *const, ULONG const);
+VOID *kHeapAlloc(RK_HEAP *const, ULONG const);
+RK_ERR kHeapFree(RK_HEAP *const, VOID *const);
+VOID *kHeapRealloc(RK_HEAP *const, VOID *const, ULONG const);
+RK_ERR kHeapGetStats(RK_HEAP *const, RK_HEAP_STATS *const);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
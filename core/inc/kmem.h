@@ -24,7 +24,19 @@ extern "C" {
 
 RK_ERR kMemPartitionInit(RK_MEM_PARTITION* const, VOID*, ULONG const, ULONG);
 VOID* kMemPartitionAlloc(RK_MEM_PARTITION* const);
+VOID* kMemPartitionAllocWait(RK_MEM_PARTITION* const, RK_TICK const);
 RK_ERR kMemPartitionFree(RK_MEM_PARTITION* const, VOID*);
+RK_ERR kMemPartitionAttachMap(RK_MEM_PARTITION* const, ULONG* const,
+                              ULONG const);
+#if (RK_CONF_ERR_CHECK == ON)
+RK_BOOL kMemPartitionBlockIsFree(RK_MEM_PARTITION const* const,
+                                 VOID const* const);
+#endif
+#if (RK_CONF_MEM_ALLOC == ON)
+RK_ERR kMemAllocInit(VOID);
+VOID* kMemAlloc(ULONG const);
+RK_ERR kMemFree(VOID* const);
+#endif
 
 #ifdef __cplusplus
 }
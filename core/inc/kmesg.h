@@ -30,6 +30,10 @@ extern "C" {
 RK_ERR kMesgEndpointInit(RK_TASK_HANDLE const);
 RK_ERR kMesgPoolInit(RK_MEM_PARTITION *const, VOID *const, ULONG const,
                      ULONG const, RK_PRIO const);
+#if (RK_CONF_HEAP == ON)
+RK_ERR kMesgPoolInitFromHeap(RK_MEM_PARTITION *const, RK_HEAP *const,
+                             ULONG const, ULONG const, RK_PRIO const);
+#endif
 RK_ERR kMesgAlloc(RK_MEM_PARTITION *const, RK_MESG **const, RK_TICK const);
 RK_ERR kMesgFree(RK_MESG *const);
 VOID *kMesgPayload(RK_MESG *const);
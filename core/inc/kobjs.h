@@ -34,7 +34,7 @@ struct  RK_STRUCT_TIMEOUT_NODE
     volatile struct RK_STRUCT_TIMEOUT_NODE **listRefPtr;
     UINT timeoutType;
     RK_TICK timeout;
-    RK_TICK dtick;
+    RK_TICK dtick;    /* delta to predecessor, or absolute expiry tick */
     RK_LIST *waitingQueuePtr;
     UINT waitInfo;    /* object-specific wake context */
 } K_ALIGN(4);
@@ -45,10 +45,23 @@ struct RK_STRUCT_LIST_NODE
     struct RK_STRUCT_LIST_NODE *prevPtr;
 } K_ALIGN(4);
 
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+/* per-priority FIFO sublists of a priority-ordered waiting queue: the bit of
+a priority is set while it has waiters, and tailPtr is its last node */
+struct RK_STRUCT_PRIO_INDEX
+{
+    ULONG prioBitmask[RK_PRIO_INDEX_WORDS];
+    struct RK_STRUCT_LIST_NODE *tailPtr[RK_RDYQSIZ];
+} K_ALIGN(4);
+#endif
+
 struct RK_STRUCT_LIST
 {
     struct RK_STRUCT_LIST_NODE listDummy;
     ULONG size;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    struct RK_STRUCT_PRIO_INDEX *prioIdxPtr; /* NULL: plain list */
+#endif
 } K_ALIGN(4);
 
 struct RK_OBJ_TCB;
@@ -62,6 +75,11 @@ struct RK_STRUCT_DYNAMIC_TASK_ATTR
     RK_PRIO priority;
     RK_OPTION preempt;
     RK_MEM_PARTITION *stackMemPtr;
+#if (RK_CONF_HEAP == ON)
+    /* alternative to stackMemPtr: a stack of stackSize words from a heap */
+    RK_HEAP *stackHeapPtr;
+    ULONG stackSize;
+#endif
 } K_ALIGN(4);
 #endif
 
@@ -77,7 +95,7 @@ struct  RK_OBJ_TCB
     ULONG stackSize;
     RK_TID tid; /* System-defined task ID */
 
-    /*priority range: 0...31, highest to lowest */
+    /*priority range: 0...RK_CONF_MIN_PRIO, highest to lowest */
     RK_PRIO priority;    /* Effective priority (in-use) */
     RK_PRIO prioNominal; /* Nominal assigned  priority  */
     ULONG preempt;       /* 1 if task is preemptable, 0 if not (exceptional) */
@@ -85,6 +103,17 @@ struct  RK_OBJ_TCB
     RK_BOOL init;
     /* --- dont change end --- */
 
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    /* priority this task is indexed by on a priority-indexed queue */
+    RK_PRIO waitQPrio;
+#endif
+
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    /* boosts currently applied, counted per priority level */
+    UINT prioContribCnt[RK_RDYQSIZ];
+    ULONG prioContribMask[RK_PRIO_CONTRIB_WORDS];
+#endif
+
     /* sleep-timers */
     /* on every sleep-release-until call this
     field is computed and replaced */
@@ -99,12 +128,43 @@ struct  RK_OBJ_TCB
     */
     RK_BOOL timeOut;
 
+#if (RK_CONF_TIME_SLICE == ON)
+    /* round-robin quantum (0: not sliced) and ticks left of it */
+    RK_TICK timeSlice;
+    RK_TICK timeSliceLeft;
+#endif
+
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+    /* only priorities above this one preempt the task while it runs */
+    RK_PRIO preemptThreshold;
+#endif
+
+#if (RK_CONF_CPU_BUDGET == ON)
+    /* ticks of execution per period (0: unlimited) and what is left */
+    RK_TICK budget;
+    RK_TICK budgetLeft;
+    RK_TICK budgetPeriod;
+    RK_TICK budgetReplenish; /* tick the budget is refilled at, if armed */
+    RK_BOOL budgetArmed;
+    RK_BOOL budgetExhausted;
+    RK_PRIO budgetBgPrio;    /* priority while exhausted */
+#endif
+
+#if (RK_CONF_EDF == ON)
+    /* relative deadline (0: none) and the absolute one of the current job */
+    RK_TICK relDeadline;
+    RK_TICK absDeadline;
+#endif
+
     /* Event Flags */
     RK_TASK_EVENT flagsCurr; /* events signalled to this task */
     RK_OPTION flagsOpt;  /* a task expects ANY or ALL of */
     RK_TASK_EVENT flagsReq;  /* the events set here */
 
 
+    /* block handed over by kMemPartitionFree() to a kMemPartitionAllocWait() */
+    VOID *memAllocBlockPtr;
+
 #if (RK_CONF_MESG_QUEUE == ON)
     VOID *mesgQueueRecvBufPtr;
 #endif
@@ -158,6 +218,7 @@ struct RK_STRUCT_RUNTIME
 {
     volatile RK_TICK globalTick;
     volatile UINT nWraps;
+    volatile ULONG tickSeq; /* odd while globalTick/nWraps are updated */
 } K_ALIGN(4);
 
 struct RK_OBJ_MEM_PARTITION
@@ -171,6 +232,13 @@ struct RK_OBJ_MEM_PARTITION
     ULONG nMaxBlocks;
     ULONG nFreeBlocks;
     struct RK_STRUCT_LIST waitingQueue;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    struct RK_STRUCT_PRIO_INDEX waitingQueueIdx;
+#endif
+#if (RK_CONF_ERR_CHECK == ON)
+    /* one bit per block, set while allocated; NULL: no map attached */
+    ULONG *allocMapPtr;
+#endif
 #if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON))
     /* Optional ceiling applied to tasks owning messages from this pool. */
     RK_PRIO mesgPrioCeiling;
@@ -178,6 +246,39 @@ struct RK_OBJ_MEM_PARTITION
 #endif
 } K_ALIGN(4);
 
+#if (RK_CONF_HEAP == ON)
+/* the free-list links overlay the payload of a free block */
+struct RK_STRUCT_HEAP_BLOCK
+{
+    struct RK_STRUCT_HEAP_BLOCK *prevPhysPtr; /* block below; NULL: first */
+    ULONG size; /* payload bytes, bit 0 set while free */
+    struct RK_STRUCT_HEAP_BLOCK *nextFreePtr;
+    struct RK_STRUCT_HEAP_BLOCK *prevFreePtr;
+} K_ALIGN(4);
+
+struct RK_STRUCT_HEAP_STATS
+{
+    ULONG totalBytes;    /* payload bytes of the empty heap */
+    ULONG usedBytes;     /* payload bytes allocated, headers excluded */
+    ULONG peakUsedBytes; /* high-water mark of usedBytes */
+    ULONG nAllocated;    /* blocks currently allocated */
+    ULONG nFailed;       /* allocations that found no block */
+};
+
+struct RK_OBJ_HEAP
+{
+    RK_ID objID;
+    CHAR objName[RK_NAME_SIZE];
+    UINT init;
+    BYTE *poolPtr;
+    ULONG poolBytes;
+    ULONG flBitmap;                    /* bit f: slBitmap[f] != 0 */
+    ULONG slBitmap[RK_HEAP_FL_COUNT];  /* bit s: freeLists[f][s] != NULL */
+    struct RK_STRUCT_HEAP_BLOCK *freeLists[RK_HEAP_FL_COUNT][RK_HEAP_SL_COUNT];
+    struct RK_STRUCT_HEAP_STATS stats;
+} K_ALIGN(4);
+#endif
+
 #if (RK_CONF_CALLOUT_TIMER == ON)
 struct RK_OBJ_TIMER
 {
@@ -190,10 +291,63 @@ struct RK_OBJ_TIMER
     RK_TICK nextTime;
     RK_TIMER_CALLOUT funPtr;
     VOID *argsPtr;
+#if (RK_CONF_TIMER_SLACK == ON)
+    RK_TICK slack;  /* tolerated lateness of an expiry */
+#endif
+#if (RK_CONF_FAST_TIMER == ON)
+    UINT fast;      /* expires in the tick handler */
+#endif
+#if (RK_CONF_TIMER_EVENT == ON)
+    RK_TASK_HANDLE evTaskPtr;   /* event timer target */
+    RK_TASK_EVENT evFlags;
+#endif
+#if (RK_CONF_TIMER_BANDS > 1U)
+    UINT band;      /* timer service band */
+#endif
     struct RK_STRUCT_TIMEOUT_NODE timeoutNode;
 } K_ALIGN(4);
 #endif
 
+#if (RK_CONF_SCHED_TABLE == ON)
+struct RK_STRUCT_SCHTBL_EP
+{
+    RK_TICK offset;      /* ticks from the table start, non-decreasing */
+    UINT action;         /* RK_SCHTBL_ACT_* */
+    VOID *objPtr;        /* task handle, semaphore or message queue */
+    RK_TASK_EVENT flags; /* RK_SCHTBL_ACT_EVENT */
+    VOID *sendPtr;       /* RK_SCHTBL_ACT_MESGQ */
+};
+
+struct RK_OBJ_SCHTBL
+{
+    RK_ID objID;
+    CHAR objName[RK_NAME_SIZE];
+    UINT init;
+    RK_BOOL running;
+    RK_SCHTBL_EP const *epArray;
+    ULONG nEp;
+    ULONG epIdx;      /* next expiry point */
+    RK_TICK duration; /* table period */
+    RK_TICK startTick;
+    RK_TICK nextTick; /* absolute tick of the next expiry point */
+    struct RK_OBJ_SCHTBL *nextPtr; /* running tables, by nextTick */
+} K_ALIGN(4);
+#endif
+
+#if (RK_CONF_HRTIMER == ON)
+struct RK_OBJ_HRTIMER
+{
+    RK_ID objID;
+    UINT init;
+    RK_BOOL armed;
+    ULONG deadline;               /* core cycle count at expiry, wrap-safe */
+    RK_TIMER_CALLOUT funPtr;
+    VOID *argsPtr;
+    struct RK_OBJ_TCB *taskPtr;   /* kSleepUs() sleeper, instead of a callout */
+    struct RK_OBJ_HRTIMER *nextPtr; /* armed hrtimers, by deadline */
+} K_ALIGN(4);
+#endif
+
 #if (RK_CONF_SEMAPHORE == ON)
 
 struct RK_OBJ_SEMAPHORE
@@ -204,6 +358,9 @@ struct RK_OBJ_SEMAPHORE
     UINT value;
     UINT maxValue;
     struct RK_STRUCT_LIST waitingQueue;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    struct RK_STRUCT_PRIO_INDEX waitingQueueIdx;
+#endif
 } K_ALIGN(4);
 
 #endif
@@ -218,8 +375,16 @@ struct RK_OBJ_MUTEX
     UINT init;
     UINT protocol;
     struct RK_STRUCT_LIST waitingQueue;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    struct RK_STRUCT_PRIO_INDEX waitingQueueIdx;
+#endif
     struct RK_OBJ_TCB *ownerPtr;
     struct RK_STRUCT_LIST_NODE mutexNode;
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    /* inheritance boost this mutex is holding on a task */
+    struct RK_OBJ_TCB *contribTaskPtr;
+    RK_PRIO contribPrio;
+#endif
 } K_ALIGN(4);
 #endif
 
@@ -230,6 +395,9 @@ struct RK_OBJ_SLEEP_QUEUE
     RK_ID objID;
     CHAR objName[RK_NAME_SIZE];
     struct RK_STRUCT_LIST waitingQueue;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    struct RK_STRUCT_PRIO_INDEX waitingQueueIdx;
+#endif
     UINT init;
 } K_ALIGN(4);
 
@@ -243,6 +411,10 @@ struct RK_OBJ_MESG_QUEUE
     UINT init;
     struct RK_STRUCT_LIST waitingReceivers;
     struct RK_STRUCT_LIST waitingSenders;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    struct RK_STRUCT_PRIO_INDEX waitingReceiversIdx;
+    struct RK_STRUCT_PRIO_INDEX waitingSendersIdx;
+#endif
     struct RK_STRUCT_RING_BUFFER ringBuf;
     ULONG broadcastReceivers;
 #if (RK_CONF_MESG_QUEUE_SEND_CALLBACK == ON)
@@ -28,8 +28,15 @@ extern RK_TCB RK_gTcbs[RK_NTHREADS]; /* Pool of RK_gTcbs */
 extern volatile RK_FAULT RK_gFaultID; /* Fault ID */
 extern UINT RK_gIdleStack[RK_CONF_IDLE_STACKSIZE]; /* Stack for idle task */
 extern UINT RK_gPostProcStack[RK_CONF_POSTPROC_STACKSIZE];
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+extern UINT RK_gTimerBandStack[RK_N_TIMER_BAND_TASKS]
+                              [RK_CONF_TIMER_BAND_STACKSIZE];
+#endif
 extern RK_TCBQ RK_gReadyQueue[RK_RDYQSIZ]; /* Table of ready queues */
 extern volatile ULONG RK_gReadyBitmask;
+#ifdef RK_READY_BITMAP_GROUPS
+extern volatile ULONG RK_gReadyGroupBitmask[RK_READY_BITMAP_GROUPS];
+#endif
 extern volatile ULONG RK_gReadyPos;
 extern volatile UINT RK_gPendingCtxtSwtch;
 extern volatile UINT RK_gSchLock;
@@ -51,6 +58,9 @@ VOID kPendCtxSwtch(VOID);
 VOID kSwtch(VOID);
 VOID kInit(VOID);
 VOID kYield(VOID);
+#if (RK_CONF_TICKLESS == ON)
+VOID kTicklessIdle(VOID);
+#endif
 #ifndef kPreemptEnable
 #define kPreemptEnable kSchUnlock
 #endif
@@ -66,12 +76,26 @@ RK_ERR kTCBQDeq(RK_TCBQ *const, RK_TCB **const);
 RK_ERR kTCBQRem(RK_TCBQ *const, RK_TCB **const);
 RK_TCB *kTCBQPeek(RK_TCBQ *const);
 RK_ERR kTCBQEnqByPrio(RK_TCBQ *const, RK_TCB *const);
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+RK_ERR kTCBQPrioIndexInit(RK_TCBQ *const, RK_PRIO_INDEX *const);
+#endif
 RK_ERR kReschedTask(RK_TCB *);
 RK_ERR kReschedRunning(VOID);
 RK_BOOL kTaskUpdateEffectivePrio(RK_TCB *const);
+#if (RK_CONF_PRIO_CONTRIB == ON)
+VOID kTaskPrioContribAdd(RK_TCB *const, RK_PRIO const);
+VOID kTaskPrioContribRem(RK_TCB *const, RK_PRIO const);
+#if (RK_CONF_MUTEX == ON)
+VOID kMutexPrioContribSync(RK_MUTEX *const);
+#endif
+#endif
 VOID kTaskUpdateEffectivePrioChain(RK_TCB *const);
 RK_ERR kReadySwtch(RK_TCB *const);
 RK_ERR kReadyNoSwtch(RK_TCB *const);
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+RK_ERR kReadyHandoff(RK_TCB *const);
+VOID kReadyHandoffUndo(RK_TCB *const);
+#endif
 RK_ERR kTaskInit(RK_TASK_HANDLE *,
                    const RK_TASKENTRY, VOID *,
                    CHAR *const, RK_STACK *const,
@@ -89,6 +113,20 @@ RK_TASK_HANDLE kTaskGetRunningHandle(VOID);
 RK_TID kTaskGetID(RK_TASK_HANDLE taskHandle);
 RK_ERR kTaskGetName(RK_TASK_HANDLE taskHandle, CHAR *buf);
 RK_PRIO kTaskGetPrio(RK_TASK_HANDLE taskHandle);
+#if (RK_CONF_TIME_SLICE == ON)
+RK_ERR kTaskSetTimeSlice(RK_TASK_HANDLE const, RK_TICK const);
+#endif
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+RK_ERR kTaskSetPreemptThreshold(RK_TASK_HANDLE const, RK_PRIO const);
+#endif
+#if (RK_CONF_CPU_BUDGET == ON)
+RK_ERR kTaskSetBudget(RK_TASK_HANDLE const, RK_TICK const, RK_TICK const,
+                      RK_PRIO const);
+#endif
+#if (RK_CONF_EDF == ON)
+RK_ERR kTaskSetDeadline(RK_TASK_HANDLE const, RK_TICK const);
+VOID kTaskDeadlineRelease(RK_TCB *const, RK_TICK const);
+#endif
 
 
 
@@ -24,6 +24,9 @@ extern "C" {
 #endif
 extern RK_TASK_HANDLE RK_gPostProcTaskHandle;
 extern RK_TASK_HANDLE RK_gIdleTaskHandle;
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+extern RK_TASK_HANDLE RK_gTimerBandTaskHandle[RK_N_TIMER_BAND_TASKS];
+#endif
 
 /* Post-processing deferral threshold:
  * if an ISR would wake/flush more than this many tasks, the work is deferred.
@@ -39,6 +42,9 @@ extern RK_TASK_HANDLE RK_gIdleTaskHandle;
 
 void IdleTask(void*);
 void PostProcSysTask(void*);
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+void TimerBandSysTask(void*);
+#endif
 RK_ERR kPostProcJobEnq(UINT jobType, VOID *const objPtr, UINT nTasks);
 #if defined(RK_QEMU_UNIT_TEST)
 VOID kPostProcTestReset(VOID);
@@ -38,10 +38,65 @@ RK_ERR kTimerDestroy(RK_TIMER_HANDLE *const);
 RK_ERR kTimerCancel(RK_TIMER*);
 VOID kRemoveTimerNode(RK_TIMEOUT_NODE*);
 VOID kTimerReload(RK_TIMER*, RK_TICK);
+VOID kTimerExpire(RK_TIMER *const);
+#if ((RK_CONF_FAST_TIMER == ON) || (RK_CONF_TIMER_EVENT == ON))
+UINT kTimerFastHandle(volatile RK_TIMEOUT_NODE **const);
+#endif
+#if (RK_CONF_TIMER_BANDS > 1U)
+RK_ERR kTimerSetBand(RK_TIMER *const, UINT const);
+#endif
+#if (RK_CONF_TIMER_EVENT == ON)
+RK_ERR kTimerInitEvent(RK_TIMER *const, RK_TICK const, RK_TICK const,
+                       RK_TASK_HANDLE const, RK_TASK_EVENT const,
+                       RK_OPTION const);
+#endif
+#if (RK_CONF_TIMER_SLACK == ON)
+RK_ERR kTimerSetSlack(RK_TIMER *const, RK_TICK const);
+#endif
+#endif
+
+#if (RK_CONF_SCHED_TABLE == ON)
+extern RK_SCHTBL *RK_gSchTblListPtr;
+RK_ERR kSchTblInit(RK_SCHTBL *const, RK_SCHTBL_EP const *const, ULONG const,
+                   RK_TICK const);
+RK_ERR kSchTblStart(RK_SCHTBL *const, RK_TICK const);
+RK_ERR kSchTblStop(RK_SCHTBL *const);
+UINT kSchTblHandle(VOID);
+#endif
+
+#if (RK_CONF_HRTIMER == ON)
+RK_ERR kHrTimerInit(RK_HRTIMER *const, RK_TIMER_CALLOUT const, VOID *const);
+RK_ERR kHrTimerStart(RK_HRTIMER *const, ULONG const);
+RK_ERR kHrTimerCancel(RK_HRTIMER *const);
+RK_ERR kSleepUs(ULONG const);
+VOID kHrTimerCancelTask(RK_TCB *const);
+VOID kHrTimerHandler(VOID);
 #endif
 
 extern volatile RK_TIMEOUT_NODE* RK_gTimeOutListHeadPtr;
 extern volatile RK_TIMEOUT_NODE* RK_gTimerListHeadPtr;
+#if ((RK_CONF_CALLOUT_TIMER == ON) && (RK_CONF_TIMER_BANDS > 1U))
+extern volatile RK_TIMEOUT_NODE* RK_gTimerBandListPtr[RK_CONF_TIMER_BANDS - 1U];
+#endif
+#if (RK_CONF_ABS_TIMEOUT == ON)
+/* an armed node is due once the global tick reaches its expiry tick */
+#define K_TIMEOUT_NODE_DUE(nodePtr) \
+    K_TICK_IS_AFTER_EQ(RK_gRunTime.globalTick, (nodePtr)->dtick)
+#endif
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+extern volatile RK_TIMEOUT_NODE* RK_gTimeOutPendListPtr;
+VOID kTimeoutPendFlush(VOID);
+#endif
+#if (RK_CONF_TIMING_WHEEL == ON)
+extern RK_TICK RK_gWheelTick;
+extern volatile RK_TIMEOUT_NODE* RK_gTimeOutWheel[RK_CONF_TIMING_WHEEL_SLOTS];
+#if (RK_CONF_CALLOUT_TIMER == ON)
+extern volatile RK_TIMEOUT_NODE* RK_gTimerWheel[RK_CONF_TIMING_WHEEL_SLOTS];
+UINT kHandleTimerWheel(VOID);
+#endif
+RK_TICK kTimingWheelIdleTicks(RK_TICK const);
+VOID kTimingWheelStep(RK_TICK const);
+#endif
 RK_BOOL kTimeoutNodeIsArmed(RK_TIMEOUT_NODE const*);
 VOID kTimeoutNodeReset(RK_TIMEOUT_NODE*);
 RK_ERR kTimeoutNodeAdd(RK_TIMEOUT_NODE*, RK_TICK);
@@ -51,8 +106,11 @@ RK_ERR kRemoveTimeoutNode(RK_TIMEOUT_NODE*);
 extern volatile struct RK_STRUCT_RUNTIME RK_gRunTime;     /* record of run time */
 RK_ERR kSleepDelay(RK_TICK const);
 RK_TICK kTickGet(VOID);
+ULLONG kTickGet64(VOID);
 RK_ERR kSleepRelease(RK_TICK const);
 RK_TICK kTickGetMs(VOID);
+ULONG kTickGetUs(VOID);
+ULONG kTickGetCycles(VOID);
 RK_ERR kSleepUntil(RK_TICK*, RK_TICK const);
 
 #ifndef kSleepPeriodic
@@ -90,6 +148,45 @@ static inline unsigned kTickIsElapsed(RK_TICK then, RK_TICK now)
 /* Delta magnitude */
 #define K_TICK_DELTA(to, from)     ((RK_TICK)((RK_TICK)(to) - (RK_TICK)(from)))
 
+#if (RK_CONF_CALLOUT_TIMER == ON)
+/* expiry list of a timer service band; band 0 is the Post-Processing one */
+RK_FORCE_INLINE
+static inline volatile RK_TIMEOUT_NODE **kTimerBandList(UINT const band)
+{
+#if (RK_CONF_TIMER_BANDS > 1U)
+    if (band > 0U)
+    {
+        return (&RK_gTimerBandListPtr[band - 1U]);
+    }
+#endif
+    K_UNUSE(band);
+    return (&RK_gTimerListHeadPtr);
+}
+
+RK_FORCE_INLINE
+static inline volatile RK_TIMEOUT_NODE **
+kTimerBandListOf(RK_TIMER const *const kobj)
+{
+#if (RK_CONF_TIMER_BANDS > 1U)
+    return (kTimerBandList(kobj->band));
+#else
+    K_UNUSE(kobj);
+    return (&RK_gTimerListHeadPtr);
+#endif
+}
+
+/* an expired timer node still on the timer list */
+RK_FORCE_INLINE
+static inline RK_BOOL kTimerNodeIsDue(volatile RK_TIMEOUT_NODE const *nodePtr)
+{
+#if (RK_CONF_ABS_TIMEOUT == ON)
+    return ((K_TIMEOUT_NODE_DUE(nodePtr)) ? RK_TRUE : RK_FALSE);
+#else
+    return ((nodePtr->dtick == 0UL) ? RK_TRUE : RK_FALSE);
+#endif
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,8 +34,58 @@
 #error "Missing RK0 version"
 #endif
 
-#if (RK_CONF_MIN_PRIO > 31)
-#error "Invalid minimal effective priority. (Max numerical value: 31)"
+#if (RK_CONF_MIN_PRIO > 253)
+#error "Invalid minimal effective priority. (Max numerical value: 253)"
+#endif
+
+#if ((RK_CONF_EDF == ON) && (RK_CONF_EDF_PRIO > RK_CONF_MIN_PRIO))
+#error "RK_CONF_EDF_PRIO must be a user task priority."
+#endif
+
+#if ((RK_CONF_TIMING_WHEEL == ON) && \
+     ((RK_CONF_TIMING_WHEEL_SLOTS == 0UL) || \
+      ((RK_CONF_TIMING_WHEEL_SLOTS & (RK_CONF_TIMING_WHEEL_SLOTS - 1UL)) != 0UL)))
+#error "RK_CONF_TIMING_WHEEL_SLOTS must be a power of 2."
+#endif
+
+#if ((RK_CONF_TIMER_BANDS == 0U) || (RK_CONF_TIMER_BANDS > 32U))
+#error "RK_CONF_TIMER_BANDS must be from 1 to 32."
+#endif
+
+#if ((RK_CONF_TIMER_BANDS > 1U) && \
+     ((RK_CONF_TIMER_BAND_PRIO + RK_CONF_TIMER_BANDS - 2U) > RK_CONF_MIN_PRIO))
+#error "Timer service band priorities must be user task priorities."
+#endif
+
+#if ((RK_CONF_TIMING_WHEEL == ON) && (RK_CONF_ABS_TIMEOUT == ON))
+#error "RK_CONF_ABS_TIMEOUT and RK_CONF_TIMING_WHEEL are mutually exclusive."
+#endif
+
+#if (RK_CONF_MEM_ALLOC == ON)
+#if ((RK_CONF_MEM_ALLOC_MIN_SHIFT < 2UL) || (RK_CONF_MEM_ALLOC_CLASSES == 0UL))
+#error "Invalid RK_CONF_MEM_ALLOC_MIN_SHIFT or RK_CONF_MEM_ALLOC_CLASSES."
+#endif
+#if (((RK_CONF_MEM_ALLOC_CLASS_BYTES & (RK_CONF_MEM_ALLOC_CLASS_BYTES - 1UL)) != \
+      0UL) ||                                                                  \
+     (RK_CONF_MEM_ALLOC_CLASS_BYTES <                                          \
+      (1UL << (RK_CONF_MEM_ALLOC_MIN_SHIFT + RK_CONF_MEM_ALLOC_CLASSES - 1UL))))
+#error "RK_CONF_MEM_ALLOC_CLASS_BYTES: a power of 2 holding the largest class."
+#endif
+#endif
+
+#if (RK_CONF_HEAP == ON)
+#if ((RK_CONF_HEAP_MAX_SHIFT <= RK_HEAP_FL_SHIFT) ||                           \
+     (RK_CONF_HEAP_MAX_SHIFT > 31UL))
+#error "RK_CONF_HEAP_MAX_SHIFT must be from 7 to 31."
+#endif
+#endif
+
+#if ((RK_CONF_MEM_PARTITION_LOCKFREE == ON) && defined(__ARM_ARCH_6M__))
+#error "RK_CONF_MEM_PARTITION_LOCKFREE needs LDREX/STREX (ARMv7-M)."
+#endif
+
+#if ((RK_CONF_HRTIMER == ON) && !defined(QEMU_MACHINE_LM3S6965EVB))
+#error "RK_CONF_HRTIMER is only ported to the LM3S6965 (GPTM Timer 0A)."
 #endif
 
 #if defined(QEMU)
@@ -0,0 +1,626 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/******************************************************************************/
+/**                                                                           */
+/** RK0 - The Embedded Real-Time Kernel '0'                                   */
+/** (C) 2026 Antonio Giacomelli <dev@kernel0.org>                             */
+/**                                                                           */
+/** VERSION: V0.73.0                                                          */
+/**                                                                           */
+/** You may obtain a copy of the License at :                                 */
+/** http://www.apache.org/licenses/LICENSE-2.0                                */
+/**                                                                           */
+/******************************************************************************/
+/******************************************************************************/
+/* COMPONENT: VARIABLE-SIZE HEAP (TWO-LEVEL SEGREGATED FIT)                   */
+/******************************************************************************/
+
+#define RK_SOURCE_CODE
+
+#include <kheap.h>
+#include <ksch.h>
+#include <ktrace.h>
+
+#if (RK_CONF_HEAP == ON)
+
+/*
+ * Free blocks are kept in RK_HEAP_FL_COUNT x RK_HEAP_SL_COUNT lists: the first
+ * level is the power of 2 of the size, the second splits it in equal ranges.
+ * Two bitmaps tell which lists are non-empty, so finding a fit, splitting and
+ * merging with physical neighbours are all constant time.
+ *
+ * Pool layout: [hdr|payload][hdr|payload]...[hdr] (a zero-size, allocated
+ * sentinel closes it). Sizes are payload bytes, multiple of 8; bit 0 of
+ * 'size' flags a free block.
+ */
+#define K_HEAP_FREE (1UL)
+#define K_HEAP_ALIGN (1UL << RK_HEAP_ALIGN_SHIFT)
+#define K_HEAP_HDR (2UL * RK_WORD_SIZE) /* prevPhysPtr + size */
+#define K_HEAP_MIN (2UL * RK_WORD_SIZE) /* room for the free-list links */
+#define K_HEAP_SMALL (1UL << RK_HEAP_FL_SHIFT)
+#define K_HEAP_MAX (1UL << RK_CONF_HEAP_MAX_SHIFT)
+
+#define K_HEAP_SIZE(blkPtr) ((blkPtr)->size & ~K_HEAP_FREE)
+#define K_HEAP_IS_FREE(blkPtr) (((blkPtr)->size & K_HEAP_FREE) != 0UL)
+
+RK_FORCE_INLINE
+static inline VOID *kHeapPayload_(RK_HEAP_BLOCK *const blkPtr)
+{
+    return ((VOID *)((BYTE *)blkPtr + K_HEAP_HDR));
+}
+
+RK_FORCE_INLINE
+static inline RK_HEAP_BLOCK *kHeapBlockOf_(VOID *const ptr)
+{
+    return ((RK_HEAP_BLOCK *)((BYTE *)ptr - K_HEAP_HDR));
+}
+
+RK_FORCE_INLINE
+static inline RK_HEAP_BLOCK *kHeapNextPhys_(RK_HEAP_BLOCK *const blkPtr)
+{
+    return ((RK_HEAP_BLOCK *)((BYTE *)blkPtr + K_HEAP_HDR +
+                              K_HEAP_SIZE(blkPtr)));
+}
+
+/* index of the most significant set bit; x != 0 */
+RK_FORCE_INLINE
+static inline ULONG kHeapFls_(ULONG x)
+{
+    ULONG n = 0UL;
+
+    if (x >= (1UL << 16U))
+    {
+        n += 16UL;
+        x >>= 16U;
+    }
+    if (x >= (1UL << 8U))
+    {
+        n += 8UL;
+        x >>= 8U;
+    }
+    if (x >= (1UL << 4U))
+    {
+        n += 4UL;
+        x >>= 4U;
+    }
+    if (x >= (1UL << 2U))
+    {
+        n += 2UL;
+        x >>= 2U;
+    }
+    if (x >= (1UL << 1U))
+    {
+        n += 1UL;
+    }
+    return (n);
+}
+
+/* index of the least significant set bit; x != 0 */
+RK_FORCE_INLINE
+static inline ULONG kHeapFfs_(ULONG const x)
+{
+    return ((ULONG)__getReadyPrio(x & (~x + 1UL)));
+}
+
+/* request in bytes to a block size; 0 if it can never fit */
+RK_FORCE_INLINE
+static inline ULONG kHeapAdjust_(ULONG const bytes)
+{
+    if ((bytes == 0UL) || (bytes > K_HEAP_MAX))
+    {
+        return (0UL);
+    }
+
+    ULONG const size = (bytes + K_HEAP_ALIGN - 1UL) & ~(K_HEAP_ALIGN - 1UL);
+    return ((size < K_HEAP_MIN) ? K_HEAP_MIN : size);
+}
+
+RK_FORCE_INLINE
+static inline VOID kHeapMapping_(ULONG const size, ULONG *const flPtr,
+                                 ULONG *const slPtr)
+{
+    if (size < K_HEAP_SMALL)
+    {
+        *flPtr = 0UL;
+        *slPtr = size >> RK_HEAP_ALIGN_SHIFT;
+    }
+    else
+    {
+        ULONG const top = kHeapFls_(size);
+        *slPtr = (size >> (top - RK_HEAP_SL_SHIFT)) ^ RK_HEAP_SL_COUNT;
+        *flPtr = top - RK_HEAP_FL_SHIFT + 1UL;
+    }
+}
+
+static VOID kHeapInsert_(RK_HEAP *const kobj, RK_HEAP_BLOCK *const blkPtr)
+{
+    ULONG fl;
+    ULONG sl;
+    kHeapMapping_(K_HEAP_SIZE(blkPtr), &fl, &sl);
+
+    RK_HEAP_BLOCK *const headPtr = kobj->freeLists[fl][sl];
+    blkPtr->nextFreePtr = headPtr;
+    blkPtr->prevFreePtr = NULL;
+    if (headPtr != NULL)
+    {
+        headPtr->prevFreePtr = blkPtr;
+    }
+    kobj->freeLists[fl][sl] = blkPtr;
+    kobj->flBitmap |= (1UL << fl);
+    kobj->slBitmap[fl] |= (1UL << sl);
+}
+
+static VOID kHeapRemove_(RK_HEAP *const kobj, RK_HEAP_BLOCK *const blkPtr)
+{
+    ULONG fl;
+    ULONG sl;
+    kHeapMapping_(K_HEAP_SIZE(blkPtr), &fl, &sl);
+
+    RK_HEAP_BLOCK *const nextPtr = blkPtr->nextFreePtr;
+    RK_HEAP_BLOCK *const prevPtr = blkPtr->prevFreePtr;
+    if (nextPtr != NULL)
+    {
+        nextPtr->prevFreePtr = prevPtr;
+    }
+    if (prevPtr != NULL)
+    {
+        prevPtr->nextFreePtr = nextPtr;
+    }
+    else
+    {
+        kobj->freeLists[fl][sl] = nextPtr;
+        if (nextPtr == NULL)
+        {
+            kobj->slBitmap[fl] &= ~(1UL << sl);
+            if (kobj->slBitmap[fl] == 0UL)
+            {
+                kobj->flBitmap &= ~(1UL << fl);
+            }
+        }
+    }
+}
+
+/* head of the first non-empty list whose blocks all fit size bytes */
+static RK_HEAP_BLOCK *kHeapFind_(RK_HEAP const *const kobj, ULONG size)
+{
+    ULONG fl;
+    ULONG sl;
+
+    /* round up to the next list, so any of its blocks will do */
+    if (size >= K_HEAP_SMALL)
+    {
+        size += (1UL << (kHeapFls_(size) - RK_HEAP_SL_SHIFT)) - 1UL;
+    }
+    kHeapMapping_(size, &fl, &sl);
+    if (fl >= RK_HEAP_FL_COUNT)
+    {
+        return (NULL);
+    }
+
+    ULONG slMap = kobj->slBitmap[fl] & (~0UL << sl);
+    if (slMap == 0UL)
+    {
+        ULONG const flMap = kobj->flBitmap & (~0UL << (fl + 1UL));
+        if (flMap == 0UL)
+        {
+            return (NULL);
+        }
+        fl = kHeapFfs_(flMap);
+        slMap = kobj->slBitmap[fl];
+    }
+    sl = kHeapFfs_(slMap);
+    return (kobj->freeLists[fl][sl]);
+}
+
+/* absorbs the physical successor of blkPtr if it is free */
+static VOID kHeapMergeNext_(RK_HEAP *const kobj, RK_HEAP_BLOCK *const blkPtr)
+{
+    RK_HEAP_BLOCK *const nextPtr = kHeapNextPhys_(blkPtr);
+
+    if (K_HEAP_IS_FREE(nextPtr))
+    {
+        kHeapRemove_(kobj, nextPtr);
+        blkPtr->size += K_HEAP_HDR + K_HEAP_SIZE(nextPtr);
+        kHeapNextPhys_(blkPtr)->prevPhysPtr = blkPtr;
+    }
+}
+
+/* cuts blkPtr (allocated) down to size bytes and frees the tail, if the
+ * tail can hold a block */
+static VOID kHeapTrim_(RK_HEAP *const kobj, RK_HEAP_BLOCK *const blkPtr,
+                       ULONG const size)
+{
+    ULONG const blkSize = K_HEAP_SIZE(blkPtr);
+
+    if (blkSize < (size + K_HEAP_HDR + K_HEAP_MIN))
+    {
+        return;
+    }
+
+    RK_HEAP_BLOCK *const tailPtr =
+        (RK_HEAP_BLOCK *)((BYTE *)kHeapPayload_(blkPtr) + size);
+    tailPtr->prevPhysPtr = blkPtr;
+    tailPtr->size = (blkSize - size - K_HEAP_HDR) | K_HEAP_FREE;
+    blkPtr->size = size;
+    kHeapNextPhys_(tailPtr)->prevPhysPtr = tailPtr;
+    kHeapMergeNext_(kobj, tailPtr);
+    kHeapInsert_(kobj, tailPtr);
+}
+
+/* takes a free block of at least size bytes, NULL if there is none */
+static RK_HEAP_BLOCK *kHeapTake_(RK_HEAP *const kobj, ULONG const size)
+{
+    RK_HEAP_BLOCK *const blkPtr = kHeapFind_(kobj, size);
+
+    if (blkPtr != NULL)
+    {
+        kHeapRemove_(kobj, blkPtr);
+        blkPtr->size &= ~K_HEAP_FREE;
+        kHeapTrim_(kobj, blkPtr, size);
+        kobj->stats.usedBytes += K_HEAP_SIZE(blkPtr);
+        kobj->stats.nAllocated += 1UL;
+        if (kobj->stats.usedBytes > kobj->stats.peakUsedBytes)
+        {
+            kobj->stats.peakUsedBytes = kobj->stats.usedBytes;
+        }
+    }
+    else
+    {
+        kobj->stats.nFailed += 1UL;
+    }
+    return (blkPtr);
+}
+
+/* returns an allocated block, merging it with free neighbours */
+static VOID kHeapRelease_(RK_HEAP *const kobj, RK_HEAP_BLOCK *blkPtr)
+{
+    kobj->stats.usedBytes -= K_HEAP_SIZE(blkPtr);
+    kobj->stats.nAllocated -= 1UL;
+
+    blkPtr->size |= K_HEAP_FREE;
+    RK_HEAP_BLOCK *const prevPtr = blkPtr->prevPhysPtr;
+    if ((prevPtr != NULL) && K_HEAP_IS_FREE(prevPtr))
+    {
+        kHeapRemove_(kobj, prevPtr);
+        prevPtr->size += K_HEAP_HDR + K_HEAP_SIZE(blkPtr);
+        kHeapNextPhys_(prevPtr)->prevPhysPtr = prevPtr;
+        blkPtr = prevPtr;
+    }
+    kHeapMergeNext_(kobj, blkPtr);
+    kHeapInsert_(kobj, blkPtr);
+}
+
+#if (RK_CONF_ERR_CHECK == ON)
+/* is ptr the payload of an allocated block? its header must fit the pool
+ * and the next block must point back at it */
+static RK_BOOL kHeapBlockValid_(RK_HEAP const *const kobj,
+                                VOID const *const ptr)
+{
+    BYTE const *const bytePtr = (BYTE const *)ptr;
+    BYTE const *const firstPtr = kobj->poolPtr + K_HEAP_HDR;
+    BYTE const *const sentinelPtr =
+        kobj->poolPtr + kobj->poolBytes - K_HEAP_HDR;
+
+    if ((bytePtr < firstPtr) || (bytePtr >= sentinelPtr) ||
+        (((ULONG)(bytePtr - kobj->poolPtr) & (K_HEAP_ALIGN - 1UL)) != 0UL))
+    {
+        return (RK_FALSE);
+    }
+
+    RK_HEAP_BLOCK *const blkPtr = kHeapBlockOf_((VOID *)ptr);
+    if (K_HEAP_IS_FREE(blkPtr) ||
+        (K_HEAP_SIZE(blkPtr) > (ULONG)(sentinelPtr - bytePtr)))
+    {
+        return (RK_FALSE);
+    }
+
+    return ((kHeapNextPhys_(blkPtr)->prevPhysPtr == blkPtr) ? RK_TRUE
+                                                           : RK_FALSE);
+}
+#endif
+
+RK_ERR kHeapInit(RK_HEAP *const kobj, VOID *const memPtr, ULONG const bytes)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+    if ((kobj == NULL) || (memPtr == NULL))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if (kobj->init == RK_TRUE)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_DOUBLE_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_DOUBLE_INIT);
+    }
+
+#endif
+
+    /* 8-byte aligned start; whole 8-byte units only */
+    ULONG const skew = (K_HEAP_ALIGN - ((ULONG)memPtr & (K_HEAP_ALIGN - 1UL))) &
+                       (K_HEAP_ALIGN - 1UL);
+    ULONG const poolBytes =
+        (bytes > skew) ? ((bytes - skew) & ~(K_HEAP_ALIGN - 1UL)) : 0UL;
+
+    if ((poolBytes < ((2UL * K_HEAP_HDR) + K_HEAP_MIN)) ||
+        (poolBytes > K_HEAP_MAX))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    kobj->poolPtr = (BYTE *)memPtr + skew;
+    kobj->poolBytes = poolBytes;
+    kobj->flBitmap = 0UL;
+    for (ULONG fl = 0UL; fl < RK_HEAP_FL_COUNT; fl++)
+    {
+        kobj->slBitmap[fl] = 0UL;
+        for (ULONG sl = 0UL; sl < RK_HEAP_SL_COUNT; sl++)
+        {
+            kobj->freeLists[fl][sl] = NULL;
+        }
+    }
+
+    /* one free block spanning the pool, closed by the sentinel */
+    RK_HEAP_BLOCK *const blkPtr = (RK_HEAP_BLOCK *)kobj->poolPtr;
+    blkPtr->prevPhysPtr = NULL;
+    blkPtr->size = (poolBytes - (2UL * K_HEAP_HDR)) | K_HEAP_FREE;
+    RK_HEAP_BLOCK *const sentinelPtr = kHeapNextPhys_(blkPtr);
+    sentinelPtr->prevPhysPtr = blkPtr;
+    sentinelPtr->size = 0UL;
+    kHeapInsert_(kobj, blkPtr);
+
+    kobj->stats.totalBytes = K_HEAP_SIZE(blkPtr);
+    kobj->stats.usedBytes = 0UL;
+    kobj->stats.peakUsedBytes = 0UL;
+    kobj->stats.nAllocated = 0UL;
+    kobj->stats.nFailed = 0UL;
+    kobj->init = RK_TRUE;
+    kobj->objID = RK_HEAP_KOBJ_ID;
+    kobj->objName[0] = '\0';
+    kTraceRegisterObject(kobj, RK_HEAP_KOBJ_ID);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+VOID *kHeapAlloc(RK_HEAP *const kobj, ULONG const bytes)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+    if (kobj->objID != RK_HEAP_KOBJ_ID)
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+    if (!kobj->init)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+#endif
+
+    VOID *allocPtr = NULL;
+    ULONG const size = kHeapAdjust_(bytes);
+    RK_HEAP_BLOCK *const blkPtr = (size > 0UL) ? kHeapTake_(kobj, size) : NULL;
+    if (blkPtr != NULL)
+    {
+        allocPtr = kHeapPayload_(blkPtr);
+        kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_SUCCESS,
+                           kobj->stats.usedBytes);
+    }
+    else
+    {
+        kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_BUFFER_EMPTY,
+                           kobj->stats.usedBytes);
+    }
+    RK_CR_EXIT
+    return (allocPtr);
+}
+
+RK_ERR kHeapFree(RK_HEAP *const kobj, VOID *const ptr)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if ((kobj == NULL) || (ptr == NULL))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    if (kobj->objID != RK_HEAP_KOBJ_ID)
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_OBJ);
+    }
+
+    if (!kobj->init)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+    /* out of the pool, misaligned, or double free */
+    if (kHeapBlockValid_(kobj, ptr) == RK_FALSE)
+    {
+        K_ERR_HANDLER(RK_FAULT_MEM_FREE);
+        RK_CR_EXIT
+        return (RK_ERR_MEM_FREE);
+    }
+
+#endif
+
+    kHeapRelease_(kobj, kHeapBlockOf_(ptr));
+    kTraceRecordObject(kobj, RK_TRACE_OP_FREE, RK_ERR_SUCCESS,
+                       kobj->stats.usedBytes);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+VOID *kHeapRealloc(RK_HEAP *const kobj, VOID *const ptr, ULONG const bytes)
+{
+    if (ptr == NULL)
+    {
+        return (kHeapAlloc(kobj, bytes));
+    }
+
+    if (bytes == 0UL)
+    {
+        (VOID)kHeapFree(kobj, ptr);
+        return (NULL);
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+    if (kobj->objID != RK_HEAP_KOBJ_ID)
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+    if (!kobj->init)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+    if (kHeapBlockValid_(kobj, ptr) == RK_FALSE)
+    {
+        K_ERR_HANDLER(RK_FAULT_MEM_FREE);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+#endif
+
+    /* on failure the block is left as it was */
+    VOID *allocPtr = NULL;
+    RK_HEAP_BLOCK *const blkPtr = kHeapBlockOf_(ptr);
+    ULONG const size = kHeapAdjust_(bytes);
+    ULONG const blkSize = K_HEAP_SIZE(blkPtr);
+    RK_HEAP_BLOCK *const nextPtr = kHeapNextPhys_(blkPtr);
+
+    if (size == 0UL)
+    {
+        kobj->stats.nFailed += 1UL;
+    }
+    else if ((size <= blkSize) ||
+             (K_HEAP_IS_FREE(nextPtr) &&
+              ((blkSize + K_HEAP_HDR + K_HEAP_SIZE(nextPtr)) >= size)))
+    {
+        /* in place: grow into the free successor, shrink by freeing the
+         * tail */
+        kobj->stats.usedBytes -= blkSize;
+        kHeapMergeNext_(kobj, blkPtr);
+        kHeapTrim_(kobj, blkPtr, size);
+        kobj->stats.usedBytes += K_HEAP_SIZE(blkPtr);
+        if (kobj->stats.usedBytes > kobj->stats.peakUsedBytes)
+        {
+            kobj->stats.peakUsedBytes = kobj->stats.usedBytes;
+        }
+        allocPtr = ptr;
+    }
+    else
+    {
+        RK_HEAP_BLOCK *const newBlkPtr = kHeapTake_(kobj, size);
+        if (newBlkPtr != NULL)
+        {
+            /* both blocks are the caller's until the old one is released,
+             * so the copy runs with interrupts enabled: latency does not
+             * grow with the block size */
+            allocPtr = kHeapPayload_(newBlkPtr);
+            RK_CR_EXIT
+            RK_MEMCPY(allocPtr, ptr, blkSize);
+            RK_CR_ENTER
+            kHeapRelease_(kobj, blkPtr);
+        }
+    }
+    kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC,
+                       (allocPtr != NULL) ? RK_ERR_SUCCESS
+                                          : RK_ERR_BUFFER_EMPTY,
+                       kobj->stats.usedBytes);
+    RK_CR_EXIT
+    return (allocPtr);
+}
+
+RK_ERR kHeapGetStats(RK_HEAP *const kobj, RK_HEAP_STATS *const statsPtr)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+    if ((kobj == NULL) || (statsPtr == NULL))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if (kobj->objID != RK_HEAP_KOBJ_ID)
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_OBJ);
+    }
+
+    if (!kobj->init)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+#endif
+
+    *statsPtr = kobj->stats;
+    kTraceRecordObject(kobj, RK_TRACE_OP_QUERY, RK_ERR_SUCCESS,
+                       kobj->stats.usedBytes);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+#endif /* RK_CONF_HEAP */
@@ -30,6 +30,9 @@ RK_ERR kListInit(RK_LIST *const kobj)
     kobj->listDummy.nextPtr = &(kobj->listDummy);
     kobj->listDummy.prevPtr = &(kobj->listDummy);
     kobj->size = 0U;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    kobj->prioIdxPtr = NULL;
+#endif
     return (RK_ERR_SUCCESS);
 }
 
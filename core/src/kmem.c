@@ -18,15 +18,162 @@
 
 #include <kmem.h>
 #include <ksch.h>
+#include <ktimer.h>
 #include <ktrace.h>
 
+/* waitInfo of a task blocked on kMemPartitionAllocWait() */
+#define K_MEM_WAIT_BLOCK (1U)
+
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+/*
+ * The free list is a Treiber stack on LDREX/STREX. On a single core the
+ * reservation is lost on any exception, so if the head was popped and pushed
+ * back in between (ABA) the store fails and the loop retries: the head needs
+ * no tag. The counter is kept >= the listed blocks: pushes count first, pops
+ * uncount after.
+ */
+#define K_MEM_CR_AREA
+#define K_MEM_CR_ENTER
+#define K_MEM_CR_EXIT
+
+RK_FORCE_INLINE
+static inline VOID kMemAtomicInc_(ULONG *const valPtr)
+{
+    volatile ULONG *const addr = (volatile ULONG *)valPtr;
+
+    while (kStoreExcl(addr, kLoadExcl(addr) + 1UL) != 0U)
+        ;
+}
+
+RK_FORCE_INLINE
+static inline VOID kMemAtomicDec_(ULONG *const valPtr)
+{
+    volatile ULONG *const addr = (volatile ULONG *)valPtr;
+
+    while (kStoreExcl(addr, kLoadExcl(addr) - 1UL) != 0U)
+        ;
+}
+
+static inline VOID *kMemPartitionPop_(RK_MEM_PARTITION *const kobj)
+{
+    volatile ULONG *const headPtr = (volatile ULONG *)&kobj->freeListPtr;
+    ULONG head;
+
+    do
+    {
+        head = kLoadExcl(headPtr);
+        if (head == 0UL)
+        {
+            RK_CLREX
+            return (NULL);
+        }
+        /* reading the link of a block taken meanwhile is harmless: the
+         * store fails */
+    } while (kStoreExcl(headPtr, *(ULONG const *)head) != 0U);
+
+    kMemAtomicDec_(&kobj->nFreeBlocks);
+    return ((VOID *)head);
+}
+
+static inline VOID kMemPartitionPush_(RK_MEM_PARTITION *const kobj,
+                                      VOID *const blockPtr)
+{
+    volatile ULONG *const headPtr = (volatile ULONG *)&kobj->freeListPtr;
+
+    kMemAtomicInc_(&kobj->nFreeBlocks);
+    for (;;)
+    {
+        /* link first, no plain store within the exclusive pair */
+        ULONG const head = *headPtr;
+        *(ULONG *)blockPtr = head;
+        if (kLoadExcl(headPtr) != head)
+        {
+            RK_CLREX
+            continue;
+        }
+        if (kStoreExcl(headPtr, (ULONG)blockPtr) == 0U)
+        {
+            break;
+        }
+    }
+}
+#else
+#define K_MEM_CR_AREA RK_CR_AREA
+#define K_MEM_CR_ENTER RK_CR_ENTER
+#define K_MEM_CR_EXIT RK_CR_EXIT
+#endif
+
 #if (RK_CONF_ERR_CHECK == ON)
 
-/* double free? */
+#define K_MEM_MAP_WORD(idx) ((idx) >> 5U)
+#define K_MEM_MAP_BIT(idx) (1UL << ((idx) & 31UL))
+
+/* index of a block already known to belong to the pool */
 RK_FORCE_INLINE
-static inline RK_BOOL kMemPartitionFreeListContains_(RK_MEM_PARTITION const *const kobj,
-                                              VOID const *const blockPtr)
+static inline ULONG kMemPartitionBlockIdx_(RK_MEM_PARTITION const *const kobj,
+                                           VOID const *const blockPtr)
 {
+    return ((ULONG)((BYTE const *)blockPtr - kobj->poolPtr) / kobj->blkSize);
+}
+
+RK_FORCE_INLINE
+static inline VOID kMemPartitionMapSet_(RK_MEM_PARTITION *const kobj,
+                                        VOID const *const blockPtr)
+{
+    if (kobj->allocMapPtr != NULL)
+    {
+        ULONG const idx = kMemPartitionBlockIdx_(kobj, blockPtr);
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+        volatile ULONG *const wordPtr =
+            (volatile ULONG *)&kobj->allocMapPtr[K_MEM_MAP_WORD(idx)];
+        while (kStoreExcl(wordPtr, kLoadExcl(wordPtr) | K_MEM_MAP_BIT(idx)) !=
+               0U)
+            ;
+#else
+        kobj->allocMapPtr[K_MEM_MAP_WORD(idx)] |= K_MEM_MAP_BIT(idx);
+#endif
+    }
+}
+
+/* returns RK_FALSE if the block was not marked allocated */
+RK_FORCE_INLINE
+static inline RK_BOOL kMemPartitionMapClear_(RK_MEM_PARTITION *const kobj,
+                                             VOID const *const blockPtr)
+{
+    if (kobj->allocMapPtr != NULL)
+    {
+        ULONG const idx = kMemPartitionBlockIdx_(kobj, blockPtr);
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+        volatile ULONG *const wordPtr =
+            (volatile ULONG *)&kobj->allocMapPtr[K_MEM_MAP_WORD(idx)];
+        ULONG word;
+        do
+        {
+            word = kLoadExcl(wordPtr);
+        } while (kStoreExcl(wordPtr, word & ~K_MEM_MAP_BIT(idx)) != 0U);
+#else
+        ULONG const word = kobj->allocMapPtr[K_MEM_MAP_WORD(idx)];
+        kobj->allocMapPtr[K_MEM_MAP_WORD(idx)] = word & ~K_MEM_MAP_BIT(idx);
+#endif
+        return (((word & K_MEM_MAP_BIT(idx)) != 0UL) ? RK_TRUE : RK_FALSE);
+    }
+    return (RK_TRUE);
+}
+
+/* double free? blockPtr must be a valid block of the pool; without a map
+ * this walks the free list */
+RK_BOOL kMemPartitionBlockIsFree(RK_MEM_PARTITION const *const kobj,
+                                 VOID const *const blockPtr)
+{
+    if (kobj->allocMapPtr != NULL)
+    {
+        ULONG const idx = kMemPartitionBlockIdx_(kobj, blockPtr);
+        return (((kobj->allocMapPtr[K_MEM_MAP_WORD(idx)] &
+                  K_MEM_MAP_BIT(idx)) == 0UL)
+                    ? RK_TRUE
+                    : RK_FALSE);
+    }
+
     BYTE *freeBlockPtr = kobj->freeListPtr;
 
     for (ULONG i = 0UL; (i < kobj->nFreeBlocks) && (freeBlockPtr != NULL);
@@ -42,6 +189,29 @@ static inline RK_BOOL kMemPartitionFreeListContains_(RK_MEM_PARTITION const *con
 
     return (RK_FALSE);
 }
+
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+/* may blockPtr, a valid block of the pool, be freed? With a map, claiming
+ * the bit is the check, so two racing frees of one block cannot both pass */
+static RK_BOOL kMemPartitionFreeCheck_(RK_MEM_PARTITION *const kobj,
+                                       VOID const *const blockPtr)
+{
+    if (kobj->allocMapPtr != NULL)
+    {
+        return (kMemPartitionMapClear_(kobj, blockPtr));
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    RK_BOOL const freeOk =
+        ((kobj->nFreeBlocks != kobj->nMaxBlocks) &&
+         (kMemPartitionBlockIsFree(kobj, blockPtr) == RK_FALSE))
+            ? RK_TRUE
+            : RK_FALSE;
+    RK_CR_EXIT
+    return (freeOk);
+}
+#endif
 #endif
 
 RK_FORCE_INLINE
@@ -63,6 +233,101 @@ static inline RK_BOOL kMemPartitionBlockValid_(
     return (((diff % kobj->blkSize) == 0UL) ? RK_TRUE : RK_FALSE);
 }
 
+/* pops the head of the free list, if any */
+static inline VOID *kMemPartitionTake_(RK_MEM_PARTITION *const kobj)
+{
+    VOID *allocPtr = NULL;
+
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+    allocPtr = kMemPartitionPop_(kobj);
+#else
+    if (kobj->nFreeBlocks > 0)
+    {
+        allocPtr = kobj->freeListPtr;
+        RK_BARRIER
+        kobj->nFreeBlocks -= 1;
+        kobj->freeListPtr = *(VOID **)allocPtr;
+    }
+#endif
+    if (allocPtr != NULL)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        kMemPartitionMapSet_(kobj, allocPtr);
+#endif
+        kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_SUCCESS,
+                           kobj->nFreeBlocks);
+    }
+    else
+    {
+        kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_BUFFER_EMPTY,
+                           kobj->nFreeBlocks);
+    }
+    return (allocPtr);
+}
+
+/* first task blocked on kMemPartitionAllocWait(), the highest-priority one
+ * as the queue is kept by priority; message pools queue kMesgAlloc() callers
+ * here too, and kMesgFree() serves those */
+static RK_TCB *kMemPartitionBlockWaiter_(RK_MEM_PARTITION *const kobj)
+{
+    RK_NODE *nodePtr = kobj->waitingQueue.listDummy.nextPtr;
+
+    while (nodePtr != &(kobj->waitingQueue.listDummy))
+    {
+        RK_TCB *const waiterPtr = K_GET_TCB_ADDR(nodePtr);
+        if (waiterPtr->timeoutNode.waitInfo == K_MEM_WAIT_BLOCK)
+        {
+            return (waiterPtr);
+        }
+        nodePtr = nodePtr->nextPtr;
+    }
+    return (NULL);
+}
+
+/* a freed block goes straight to the highest-priority task blocked on
+ * kMemPartitionAllocWait(), never through the free list */
+static RK_BOOL kMemPartitionHandoff_(RK_MEM_PARTITION *const kobj,
+                                     VOID *const blockPtr)
+{
+    RK_TCB *waiterPtr = kMemPartitionBlockWaiter_(kobj);
+
+    if (waiterPtr == NULL)
+    {
+        return (RK_FALSE);
+    }
+
+    RK_ERR err = kTCBQRem(&kobj->waitingQueue, &waiterPtr);
+    K_ASSERT(err == RK_ERR_SUCCESS);
+    if (waiterPtr->timeoutNode.timeoutType == RK_TIMEOUT_BLOCKING)
+    {
+        kRemoveTimeoutNode(&waiterPtr->timeoutNode);
+        waiterPtr->timeoutNode.timeoutType = 0U;
+    }
+    waiterPtr->timeoutNode.waitingQueuePtr = NULL;
+    waiterPtr->timeoutNode.waitInfo = 0U;
+    waiterPtr->memAllocBlockPtr = blockPtr;
+
+    err = kReadySwtch(waiterPtr);
+    kTraceRecordObject(kobj, RK_TRACE_OP_WAKE, err, kobj->waitingQueue.size);
+    return (RK_TRUE);
+}
+
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+/* a lock-free free pushes first; a task that found the list empty and
+ * blocked before the push is served from the list here (in a CR) */
+static VOID kMemPartitionServeWaiter_(RK_MEM_PARTITION *const kobj)
+{
+    if (kMemPartitionBlockWaiter_(kobj) != NULL)
+    {
+        VOID *const blockPtr = kMemPartitionTake_(kobj);
+        if (blockPtr != NULL)
+        {
+            (VOID)kMemPartitionHandoff_(kobj, blockPtr);
+        }
+    }
+}
+#endif
+
 RK_ERR kMemPartitionInit(RK_MEM_PARTITION *const kobj, VOID *memPoolPtr,
                          ULONG blkSize, ULONG const numBlocks)
 {
@@ -126,12 +391,18 @@ RK_ERR kMemPartitionInit(RK_MEM_PARTITION *const kobj, VOID *memPoolPtr,
     kobj->nFreeBlocks = numBlocks;
     kobj->freeListPtr = memPoolPtr;
     kobj->poolPtr = memPoolPtr;
+#if (RK_CONF_ERR_CHECK == ON)
+    kobj->allocMapPtr = NULL;
+#endif
     RK_ERR const queueErr = kTCBQInit(&kobj->waitingQueue);
     if (queueErr != RK_ERR_SUCCESS)
     {
         RK_CR_EXIT
         return (queueErr);
     }
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    kTCBQPrioIndexInit(&kobj->waitingQueue, &kobj->waitingQueueIdx);
+#endif
 #if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON))
     /*
      * A plain memory partition has no message ceiling. kMesgPoolInit()
@@ -151,6 +422,42 @@ RK_ERR kMemPartitionInit(RK_MEM_PARTITION *const kobj, VOID *memPoolPtr,
 VOID *kMemPartitionAlloc(RK_MEM_PARTITION *const kobj)
 {
 
+    K_MEM_CR_AREA
+    K_MEM_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        K_MEM_CR_EXIT
+        return (NULL);
+    }
+
+    if (kobj->objID != RK_MEMALLOC_KOBJ_ID)
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        K_MEM_CR_EXIT
+        return (NULL);
+    }
+
+    if (!kobj->init)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        K_MEM_CR_EXIT
+        return (NULL);
+    }
+
+#endif
+
+    VOID *allocPtr = kMemPartitionTake_(kobj);
+    K_MEM_CR_EXIT
+    return (allocPtr);
+}
+
+VOID *kMemPartitionAllocWait(RK_MEM_PARTITION *const kobj,
+                             RK_TICK const timeout)
+{
     RK_CR_AREA
     RK_CR_ENTER
 
@@ -177,24 +484,66 @@ VOID *kMemPartitionAlloc(RK_MEM_PARTITION *const kobj)
         return (NULL);
     }
 
+    if (K_BLOCKING_ON_ISR(timeout))
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_ISR_PRIMITIVE);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
+    if ((timeout != RK_WAIT_FOREVER) && (timeout > RK_MAX_PERIOD))
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_TIMEOUT);
+        RK_CR_EXIT
+        return (NULL);
+    }
+
 #endif
 
-    VOID *allocPtr = NULL;
+    VOID *allocPtr = kMemPartitionTake_(kobj);
+    if ((allocPtr != NULL) || (timeout == RK_NO_WAIT) || kIsISR())
+    {
+        RK_CR_EXIT
+        return (allocPtr);
+    }
 
-    if (kobj->nFreeBlocks > 0)
+    if (timeout != RK_WAIT_FOREVER)
     {
-        allocPtr = kobj->freeListPtr;
-        RK_BARRIER
-        kobj->nFreeBlocks -= 1;
-        kobj->freeListPtr = *(VOID **)allocPtr;
-        kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_SUCCESS,
-                           kobj->nFreeBlocks);
+        RK_TASK_TIMEOUT_WAITINGQUEUE_SETUP
+
+        RK_ERR err = kTimeoutNodeAdd(&RK_gRunPtr->timeoutNode, timeout);
+        if (err != RK_ERR_SUCCESS)
+        {
+            RK_gRunPtr->timeoutNode.timeoutType = 0;
+            RK_gRunPtr->timeoutNode.waitingQueuePtr = NULL;
+            RK_CR_EXIT
+            return (NULL);
+        }
     }
-    else
+    RK_gRunPtr->timeoutNode.waitInfo = K_MEM_WAIT_BLOCK;
+    RK_gRunPtr->memAllocBlockPtr = NULL;
+    RK_gRunPtr->status = RK_BLOCKED;
+    kTraceRecordObject(kobj, RK_TRACE_OP_WAIT_BLOCK, RK_ERR_SUCCESS,
+                       kobj->waitingQueue.size + 1UL);
+    kTCBQEnqByPrio(&kobj->waitingQueue, RK_gRunPtr);
+    kPendCtxSwtch();
+    RK_CR_EXIT
+    RK_CR_ENTER
+    if (RK_gRunPtr->timeOut)
     {
-        kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_BUFFER_EMPTY,
-                           kobj->nFreeBlocks);
+        RK_gRunPtr->timeOut = RK_FALSE;
+        RK_gRunPtr->timeoutNode.waitInfo = 0U;
+        kTraceRecordObject(kobj, RK_TRACE_OP_TIMEOUT, RK_ERR_TIMEOUT,
+                           kobj->waitingQueue.size);
+        RK_CR_EXIT
+        return (NULL);
     }
+
+    /* kMemPartitionFree() took this task off the queue and its time-out */
+    allocPtr = RK_gRunPtr->memAllocBlockPtr;
+    RK_gRunPtr->memAllocBlockPtr = NULL;
+    kTraceRecordObject(kobj, RK_TRACE_OP_ALLOC, RK_ERR_SUCCESS,
+                       kobj->nFreeBlocks);
     RK_CR_EXIT
     return (allocPtr);
 }
@@ -202,45 +551,78 @@ VOID *kMemPartitionAlloc(RK_MEM_PARTITION *const kobj)
 RK_ERR kMemPartitionFree(RK_MEM_PARTITION *const kobj, VOID *blockPtr)
 {
 
-    RK_CR_AREA
-    RK_CR_ENTER
+    K_MEM_CR_AREA
+    K_MEM_CR_ENTER
 
 #if (RK_CONF_ERR_CHECK == ON)
 
     if (kobj == NULL || blockPtr == NULL)
     {
         K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
-        RK_CR_EXIT
+        K_MEM_CR_EXIT
         return (RK_ERR_OBJ_NULL);
     }
 
     if (kobj->objID != RK_MEMALLOC_KOBJ_ID)
     {
         K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
-        RK_CR_EXIT
+        K_MEM_CR_EXIT
         return (RK_ERR_INVALID_OBJ);
     }
 
     if (!kobj->init)
     {
         K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
-        RK_CR_EXIT
+        K_MEM_CR_EXIT
         return (RK_ERR_OBJ_NOT_INIT);
     }
 
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+    if ((kMemPartitionBlockValid_(kobj, blockPtr) == RK_FALSE) ||
+        /* check for double free */
+        (kMemPartitionFreeCheck_(kobj, blockPtr) == RK_FALSE))
+    {
+        K_ERR_HANDLER(RK_FAULT_MEM_FREE);
+        return (RK_ERR_MEM_FREE);
+    }
+#else
     /* all blocks belonging to this pool are free */
     RK_BOOL allFree = (kobj->nFreeBlocks == kobj->nMaxBlocks);
     if ((kMemPartitionBlockValid_(kobj, blockPtr) == RK_FALSE) || allFree ||
         /* check for double free */
-        (kMemPartitionFreeListContains_(kobj, blockPtr) != RK_FALSE))
+        (kMemPartitionBlockIsFree(kobj, blockPtr) != RK_FALSE))
     {
         K_ERR_HANDLER(RK_FAULT_MEM_FREE);
         RK_CR_EXIT
         return (RK_ERR_MEM_FREE);
     }
+#endif
 
 #endif
 
+#if (RK_CONF_MEM_PARTITION_LOCKFREE == ON)
+    kMemPartitionPush_(kobj, blockPtr);
+    kTraceRecordObject(kobj, RK_TRACE_OP_FREE, RK_ERR_SUCCESS,
+                       kobj->nFreeBlocks);
+    if (kobj->waitingQueue.size > 0UL)
+    {
+        RK_CR_AREA
+        RK_CR_ENTER
+        kMemPartitionServeWaiter_(kobj);
+        RK_CR_EXIT
+    }
+    return (RK_ERR_SUCCESS);
+#else
+    if ((kobj->waitingQueue.size > 0UL) &&
+        (kMemPartitionHandoff_(kobj, blockPtr) == RK_TRUE))
+    {
+        RK_CR_EXIT
+        return (RK_ERR_SUCCESS);
+    }
+
+#if (RK_CONF_ERR_CHECK == ON)
+    (VOID)kMemPartitionMapClear_(kobj, blockPtr);
+#endif
     *(VOID **)blockPtr = kobj->freeListPtr;
     kobj->freeListPtr = blockPtr;
     kobj->nFreeBlocks += 1;
@@ -248,4 +630,151 @@ RK_ERR kMemPartitionFree(RK_MEM_PARTITION *const kobj, VOID *blockPtr)
                        kobj->nFreeBlocks);
     RK_CR_EXIT
     return (RK_ERR_SUCCESS);
+#endif
 }
+
+RK_ERR kMemPartitionAttachMap(RK_MEM_PARTITION *const kobj,
+                              ULONG *const mapPtr, ULONG const nWords)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+    if ((kobj == NULL) || (mapPtr == NULL))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if (kobj->objID != RK_MEMALLOC_KOBJ_ID)
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_OBJ);
+    }
+
+    if (!kobj->init)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+#endif
+
+    /* the map starts all-free, so no block may be out yet */
+    if ((nWords < RK_MEM_POOL_MAP_WORDS(kobj->nMaxBlocks)) ||
+        (kobj->nFreeBlocks != kobj->nMaxBlocks))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+#if (RK_CONF_ERR_CHECK == ON)
+    for (ULONG i = 0UL; i < nWords; i++)
+    {
+        mapPtr[i] = 0UL;
+    }
+    kobj->allocMapPtr = mapPtr;
+#endif
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+#if (RK_CONF_MEM_ALLOC == ON)
+/******************************************************************************/
+/* SIZE-CLASS ALLOCATOR                                                       */
+/******************************************************************************/
+/* class c serves blocks of 2^(RK_CONF_MEM_ALLOC_MIN_SHIFT + c) bytes out of
+ * its own region of the arena, so a block address divided by the region size
+ * gives its class */
+#define K_MEM_CLASS_BLKSIZE(c) (1UL << (RK_CONF_MEM_ALLOC_MIN_SHIFT + (c)))
+
+static ULONG RK_gMemAllocArena[(RK_CONF_MEM_ALLOC_CLASSES *
+                                RK_CONF_MEM_ALLOC_CLASS_BYTES) /
+                               RK_WORD_SIZE] K_ALIGN(8);
+static RK_MEM_PARTITION RK_gMemAllocClass[RK_CONF_MEM_ALLOC_CLASSES];
+#if (RK_CONF_ERR_CHECK == ON)
+/* sized for class 0, the one with most blocks */
+static ULONG RK_gMemAllocMap[RK_CONF_MEM_ALLOC_CLASSES][RK_MEM_POOL_MAP_WORDS(
+    RK_CONF_MEM_ALLOC_CLASS_BYTES >> RK_CONF_MEM_ALLOC_MIN_SHIFT)];
+#endif
+
+RK_ERR kMemAllocInit(VOID)
+{
+    BYTE *regionPtr = (BYTE *)RK_gMemAllocArena;
+
+    for (ULONG c = 0UL; c < RK_CONF_MEM_ALLOC_CLASSES; c++)
+    {
+        RK_ERR err = kMemPartitionInit(
+            &RK_gMemAllocClass[c], regionPtr, K_MEM_CLASS_BLKSIZE(c),
+            RK_CONF_MEM_ALLOC_CLASS_BYTES / K_MEM_CLASS_BLKSIZE(c));
+        if (err != RK_ERR_SUCCESS)
+        {
+            return (err);
+        }
+#if (RK_CONF_ERR_CHECK == ON)
+        err = kMemPartitionAttachMap(&RK_gMemAllocClass[c],
+                                     RK_gMemAllocMap[c],
+                                     RK_MEM_POOL_MAP_WORDS(
+                                         RK_CONF_MEM_ALLOC_CLASS_BYTES >>
+                                         RK_CONF_MEM_ALLOC_MIN_SHIFT));
+        if (err != RK_ERR_SUCCESS)
+        {
+            return (err);
+        }
+#endif
+        regionPtr += RK_CONF_MEM_ALLOC_CLASS_BYTES;
+    }
+    return (RK_ERR_SUCCESS);
+}
+
+VOID *kMemAlloc(ULONG const bytes)
+{
+    if ((bytes == 0UL) ||
+        (bytes > K_MEM_CLASS_BLKSIZE(RK_CONF_MEM_ALLOC_CLASSES - 1UL)))
+    {
+        return (NULL);
+    }
+
+    ULONG c = 0UL;
+    while (K_MEM_CLASS_BLKSIZE(c) < bytes)
+    {
+        c++;
+    }
+
+    /* a drained class spills over to the next larger one */
+    VOID *allocPtr = NULL;
+    for (; (c < RK_CONF_MEM_ALLOC_CLASSES) && (allocPtr == NULL); c++)
+    {
+        allocPtr = kMemPartitionAlloc(&RK_gMemAllocClass[c]);
+    }
+    return (allocPtr);
+}
+
+RK_ERR kMemFree(VOID *const blockPtr)
+{
+    BYTE const *const arenaPtr = (BYTE const *)RK_gMemAllocArena;
+    BYTE const *const bytePtr = (BYTE const *)blockPtr;
+
+    if ((bytePtr < arenaPtr) ||
+        (bytePtr >= (arenaPtr + sizeof(RK_gMemAllocArena))))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_MEM_FREE);
+#endif
+        return (RK_ERR_MEM_FREE);
+    }
+
+    ULONG const c =
+        (ULONG)(bytePtr - arenaPtr) / RK_CONF_MEM_ALLOC_CLASS_BYTES;
+    return (kMemPartitionFree(&RK_gMemAllocClass[c], blockPtr));
+}
+#endif
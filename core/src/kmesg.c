@@ -37,6 +37,7 @@
 
 #include <kmesg.h>
 #include <kmem.h>
+#include <kheap.h>
 #include <ksch.h>
 #include <ktimer.h>
 #include <ktrace.h>
@@ -140,12 +141,26 @@ static VOID kMesgSetOwner_(RK_MESG *const mesgPtr,
         return;
     }
 
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    RK_MEM_PARTITION const *const poolPtr = mesgPtr->poolPtr;
+    RK_BOOL const hasCeiling =
+        ((poolPtr != NULL) && (poolPtr->mesgPrioCeilingEnabled == RK_TRUE))
+            ? RK_TRUE
+            : RK_FALSE;
+#endif
+
     if (oldOwnerPtr != NULL)
     {
         RK_ERR const err =
             kListRemove(&oldOwnerPtr->asynchMesgOwnedList,
                         &mesgPtr->ownerNode);
         K_ASSERT(err == RK_ERR_SUCCESS);
+#if (RK_CONF_PRIO_CONTRIB == ON)
+        if (hasCeiling == RK_TRUE)
+        {
+            kTaskPrioContribRem(oldOwnerPtr, poolPtr->mesgPrioCeiling);
+        }
+#endif
     }
 
     mesgPtr->owner = ownerPtr;
@@ -158,6 +173,12 @@ static VOID kMesgSetOwner_(RK_MESG *const mesgPtr,
             kListAddTail(&ownerPtr->asynchMesgOwnedList,
                          &mesgPtr->ownerNode);
         K_ASSERT(err == RK_ERR_SUCCESS);
+#if (RK_CONF_PRIO_CONTRIB == ON)
+        if (hasCeiling == RK_TRUE)
+        {
+            kTaskPrioContribAdd(ownerPtr, poolPtr->mesgPrioCeiling);
+        }
+#endif
     }
 
     if (oldOwnerPtr != NULL)
@@ -515,6 +536,49 @@ RK_ERR kMesgPoolInit(RK_MEM_PARTITION *const poolPtr,
     return (RK_ERR_SUCCESS);
 }
 
+#if (RK_CONF_HEAP == ON)
+RK_ERR kMesgPoolInitFromHeap(RK_MEM_PARTITION *const poolPtr,
+                             RK_HEAP *const heapPtr,
+                             ULONG const payloadBytes,
+                             ULONG const nMesg,
+                             RK_PRIO const ceilingPrio)
+{
+    ULONG const blockBytes = kMesgBlockBytes_(payloadBytes);
+
+    if ((heapPtr == NULL) || (poolPtr == NULL))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    if ((blockBytes == 0UL) || (nMesg == 0UL) ||
+        (nMesg > (RK_ULONG_MAX / blockBytes)))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    /* the backing store stays with the pool for good */
+    VOID *const memPoolPtr = kHeapAlloc(heapPtr, blockBytes * nMesg);
+    if (memPoolPtr == NULL)
+    {
+        return (RK_ERR_MEM_INIT);
+    }
+
+    RK_ERR const err = kMesgPoolInit(poolPtr, memPoolPtr, payloadBytes, nMesg,
+                                     ceilingPrio);
+    if (err != RK_ERR_SUCCESS)
+    {
+        (VOID)kHeapFree(heapPtr, memPoolPtr);
+    }
+    return (err);
+}
+#endif
+
 RK_ERR kMesgAlloc(RK_MEM_PARTITION *const poolPtr,
                   RK_MESG **const mesgPtrPtr,
                   RK_TICK const timeout)
@@ -744,7 +808,12 @@ RK_ERR kMesgFree(RK_MESG *const mesgPtr)
         return (RK_ERR_INVALID_OBJ);
     }
 
-    if (poolPtr->waitingQueue.size > 0UL)
+    /*
+     * A kMemPartitionAllocWait() caller may head the queue too; it has no
+     * message destination and is served by kMemPartitionFree() below.
+     */
+    if ((poolPtr->waitingQueue.size > 0UL) &&
+        (kTCBQPeek(&poolPtr->waitingQueue)->asynchMesgAllocDestPtr != NULL))
     {
         /*
          * A waiting allocator takes ownership immediately, so the ceiling moves
@@ -756,8 +825,9 @@ RK_ERR kMesgFree(RK_MESG *const mesgPtr)
     }
 
     /*
-     * No allocator is waiting. Clear ownership before returning the buffer to
-     * the pool so the freeing task loses this pool's ceiling contribution.
+     * No message allocator is waiting. Clear ownership before returning the
+     * buffer to the pool so the freeing task loses this pool's ceiling
+     * contribution.
      */
     kMesgSetOwner_(mesgPtr, NULL);
     mesgPtr->sender = NULL;
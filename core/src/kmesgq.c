@@ -96,6 +96,10 @@ RK_ERR kMesgQueueInit(RK_MESG_QUEUE *const kobj, VOID *const bufPtr,
         RK_CR_EXIT
         return (err);
     }
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    kTCBQPrioIndexInit(&kobj->waitingReceivers, &kobj->waitingReceiversIdx);
+    kTCBQPrioIndexInit(&kobj->waitingSenders, &kobj->waitingSendersIdx);
+#endif
     kobj->init = 1;
     kobj->objID = RK_MESGQQUEUE_KOBJ_ID;
     kobj->objName[0] = '\0';
@@ -161,8 +165,7 @@ static RK_ERR kMesgQueueDeqNormalReceiver_(RK_MESG_QUEUE *const kobj,
         RK_TCB *taskPtr = K_GET_TCB_ADDR(nodePtr);
         if (taskPtr->timeoutNode.waitInfo != RK_MESGQ_RECV_WAIT_BROADCAST)
         {
-            RK_ERR err = kListRemove(&kobj->waitingReceivers,
-                                     &taskPtr->tcbNode);
+            RK_ERR err = kTCBQRem(&kobj->waitingReceivers, &taskPtr);
             if (err == RK_ERR_SUCCESS)
             {
                 taskPtr->timeoutNode.waitInfo = RK_MESGQ_RECV_WAIT_NORMAL;
@@ -258,13 +261,12 @@ RK_ERR kMesgQueueBroadcastWake(RK_MESG_QUEUE *const kobj, UINT const nTasks)
     while ((woken < nTasks) && (nodePtr != &kobj->waitingReceivers.listDummy))
     {
         RK_NODE *const nextPtr = nodePtr->nextPtr;
-        RK_TCB *const recvTaskPtr = K_GET_TCB_ADDR(nodePtr);
+        RK_TCB *recvTaskPtr = K_GET_TCB_ADDR(nodePtr);
 
         if (recvTaskPtr->timeoutNode.waitInfo ==
             RK_MESGQ_RECV_BROADCAST_DELIVER)
         {
-            RK_ERR err = kListRemove(&kobj->waitingReceivers,
-                                     &recvTaskPtr->tcbNode);
+            RK_ERR err = kTCBQRem(&kobj->waitingReceivers, &recvTaskPtr);
             K_ASSERT(err == RK_ERR_SUCCESS);
             kMesgQueueReadyTopTask_(&chosenTCBPtr, recvTaskPtr);
             woken++;
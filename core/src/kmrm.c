@@ -56,25 +56,6 @@ static RK_BOOL kMRMPartOwnsBlock_(RK_MEM_PARTITION const *const partPtr,
     return (((diff % partPtr->blkSize) == 0UL) ? RK_TRUE : RK_FALSE);
 }
 
-static RK_BOOL kMRMPartFreeListContains_(RK_MEM_PARTITION const *const partPtr,
-                                         VOID const *const blockPtr)
-{
-    BYTE *freeBlockPtr = partPtr->freeListPtr;
-
-    for (ULONG i = 0UL; (i < partPtr->nFreeBlocks) && (freeBlockPtr != NULL);
-         i++)
-    {
-        if ((VOID const *)freeBlockPtr == blockPtr)
-        {
-            return (RK_TRUE);
-        }
-
-        freeBlockPtr = *(BYTE **)freeBlockPtr;
-    }
-
-    return (RK_FALSE);
-}
-
 static RK_BOOL kMRMPartOwnsAllocatedBlock_(RK_MEM_PARTITION const *const partPtr,
                                            VOID const *const blockPtr,
                                            ULONG const minSize)
@@ -84,7 +65,7 @@ static RK_BOOL kMRMPartOwnsAllocatedBlock_(RK_MEM_PARTITION const *const partPtr
         return (RK_FALSE);
     }
 
-    return ((kMRMPartFreeListContains_(partPtr, blockPtr) == RK_FALSE)
+    return ((kMemPartitionBlockIsFree(partPtr, blockPtr) == RK_FALSE)
                 ? RK_TRUE
                 : RK_FALSE);
 }
@@ -48,6 +48,15 @@ static VOID kMutexUpdateOwnerPrio_(RK_TCB *ownerTcb)
     kTaskUpdateEffectivePrioChain(ownerTcb);
 }
 
+static inline VOID kMutexSyncPrioContrib_(RK_MUTEX *const kobj)
+{
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    kMutexPrioContribSync(kobj);
+#else
+    (VOID)kobj;
+#endif
+}
+
 VOID kMutexTimeoutWaiter(RK_TCB *const waiterPtr)
 {
     if ((waiterPtr == NULL) || (waiterPtr->waitingForMutexPtr == NULL))
@@ -59,6 +68,7 @@ VOID kMutexTimeoutWaiter(RK_TCB *const waiterPtr)
     if ((mtxPtr->protocol == RK_PRIO_INHERITANCE) &&
         (mtxPtr->ownerPtr != NULL))
     {
+        kMutexSyncPrioContrib_(mtxPtr);
         kMutexUpdateOwnerPrio_(mtxPtr->ownerPtr);
     }
 }
@@ -96,12 +106,19 @@ RK_ERR kMutexInit(RK_MUTEX *const kobj, UINT const protocol)
     }
 
     kTCBQInit(&(kobj->waitingQueue));
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    kTCBQPrioIndexInit(&kobj->waitingQueue, &kobj->waitingQueueIdx);
+#endif
     kobj->init = RK_TRUE;
     kobj->protocol = protocol;
     kobj->objID = RK_MUTEX_KOBJ_ID;
     kobj->objName[0] = '\0';
     kobj->lock = RK_FALSE;
     kobj->ownerPtr = NULL;
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    kobj->contribTaskPtr = NULL;
+    kobj->contribPrio = 0U;
+#endif
     kTraceRegisterObject(kobj, RK_MUTEX_KOBJ_ID);
     RK_CR_EXIT
     return (RK_ERR_SUCCESS);
@@ -194,6 +211,7 @@ RK_ERR kMutexLock(RK_MUTEX *const kobj, RK_TICK const timeout)
         RK_gRunPtr->waitingForMutexPtr = kobj;
         if (kobj->protocol == RK_PRIO_INHERITANCE)
         {
+            kMutexSyncPrioContrib_(kobj);
             kMutexUpdateOwnerPrio_(kobj->ownerPtr);
         }
 
@@ -208,6 +226,7 @@ RK_ERR kMutexLock(RK_MUTEX *const kobj, RK_TICK const timeout)
             if ((kobj->protocol == RK_PRIO_INHERITANCE) &&
                 (kobj->ownerPtr != NULL))
             {
+                kMutexSyncPrioContrib_(kobj);
                 kMutexUpdateOwnerPrio_(kobj->ownerPtr);
             }
 
@@ -304,6 +323,7 @@ RK_ERR kMutexUnlock(RK_MUTEX *const kobj)
 
         if (kobj->protocol == RK_PRIO_INHERITANCE)
         {
+            kMutexSyncPrioContrib_(kobj);
             kMutexUpdateOwnerPrio_(RK_gRunPtr);
             RK_BARRIER
         }
@@ -326,6 +346,7 @@ RK_ERR kMutexUnlock(RK_MUTEX *const kobj)
 
         if (kobj->protocol == RK_PRIO_INHERITANCE)
         {
+            kMutexSyncPrioContrib_(kobj);
             kMutexUpdateOwnerPrio_(RK_gRunPtr);
             kMutexUpdateOwnerPrio_(tcbPtr);
         }
@@ -19,6 +19,7 @@
 #include <ksch.h>
 #include <kcoredefs.h>
 #include <kmem.h>
+#include <kheap.h>
 #include <ksystasks.h>
 #include <ktimer.h>
 #include <ktrace.h>
@@ -27,11 +28,22 @@
 RK_TCBQ RK_gReadyQueue[RK_RDYQSIZ]; /* Table of ready queues */
 RK_TCB *RK_gRunPtr;
 RK_TCB RK_gTcbs[RK_NTHREADS];
+#if (RK_CONF_ERR_CHECK == ON)
+static ULONG RK_gTcbMap[RK_MEM_POOL_MAP_WORDS(RK_NTHREADS)];
+#endif
 RK_TASK_HANDLE RK_gPostProcTaskHandle;
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+RK_TASK_HANDLE RK_gTimerBandTaskHandle[RK_N_TIMER_BAND_TASKS];
+#endif
 RK_TASK_HANDLE RK_gIdleTaskHandle;
 volatile struct RK_STRUCT_RUNTIME RK_gRunTime;
 volatile ULONG RK_gReadyBitmask;
 volatile ULONG RK_gReadyPos;
+#ifdef RK_READY_BITMAP_GROUPS
+/* RK_gReadyBitmask bit g is set while any priority in group g (32g...32g+31)
+is ready; the per-priority bits live here */
+volatile ULONG RK_gReadyGroupBitmask[RK_READY_BITMAP_GROUPS];
+#endif
 volatile UINT RK_gPendingCtxtSwtch = 0;
 volatile UINT RK_gSchLock = 0;
 /* local globals  */
@@ -39,12 +51,24 @@ static RK_PRIO highestPrio = 0;
 static RK_PRIO const lowestPrio = RK_CONF_MIN_PRIO;
 static volatile RK_PRIO nextTaskPrio = 0;
 static RK_PRIO const idleTaskPrio = RK_CONF_MIN_PRIO + 1;
+#ifdef RK_READY_BITMAP_GROUPS
+static ULONG const readyBitmaskPrioLimit = RK_READY_BITMAP_GROUPS * 32U;
+#else
 static RK_PRIO const readyBitmaskPrioLimit = sizeof(ULONG) * 8U;
+#endif
 static RK_TID pPid = 0; /* number of active tasks */
 static RK_BOOL RK_gTaskPoolInit = RK_FALSE;
 static RK_BOOL RK_gSystemTasksInit = RK_FALSE;
 static RK_MEM_PARTITION RK_gTaskPool;
 static RK_MEM_PARTITION *RK_gTaskDynStackPartByPid[RK_NTHREADS];
+#if (RK_CONF_HEAP == ON)
+static RK_HEAP *RK_gTaskDynStackHeapByPid[RK_NTHREADS];
+/* kTaskSpawn() takes the stack from a heap when no partition is given */
+#define K_TASK_STACK_FROM_HEAP(attrPtr)                                        \
+    (((attrPtr)->stackMemPtr == NULL) && ((attrPtr)->stackHeapPtr != NULL))
+#else
+#define K_TASK_STACK_FROM_HEAP(attrPtr) (RK_FALSE)
+#endif
 static RK_TASK_HANDLE RK_gTaskHandleByPid[RK_NTHREADS];
 
 static inline VOID kPendCtxSwtchNow_(VOID)
@@ -63,6 +87,35 @@ static inline VOID kDeferCtxSwtch_(VOID)
 
 static inline RK_PRIO kCalcNextTaskPrio_(VOID);
 
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+/* task to be dispatched by the next kSwtch() without a ready queue trip */
+static RK_TCB *RK_gHandoffPtr = NULL;
+#endif
+
+/* a READY task must be of higher priority than this to preempt RUNNING */
+static inline RK_PRIO kRunPreemptLevel_(VOID)
+{
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+    return ((RK_gRunPtr->preemptThreshold < RK_gRunPtr->priority)
+                ? RK_gRunPtr->preemptThreshold
+                : RK_gRunPtr->priority);
+#else
+    return (RK_gRunPtr->priority);
+#endif
+}
+
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+/* RK_TRUE when a raised threshold keeps every READY task out */
+static inline RK_BOOL kRunThresholdHolds_(VOID)
+{
+    RK_PRIO const level = kRunPreemptLevel_();
+    return (((level < RK_gRunPtr->priority) &&
+             (kCalcNextTaskPrio_() >= level))
+                ? RK_TRUE
+                : RK_FALSE);
+}
+#endif
+
 /* compile-time assertions trick */
 #ifndef RK_DISABLE_TCB_LAYOUT_ASSERTS
 typedef char RK_TCB_SP_OFFSET_ASSERT[(offsetof(RK_TCB, sp) == 0U) ? 1 : -1];
@@ -93,6 +146,13 @@ VOID kPendCtxSwtch(VOID)
     {
         kPendCtxSwtchNow_();
     }
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+    else if ((RK_gRunPtr != NULL) && (kRunThresholdHolds_() == RK_TRUE))
+    {
+        /* nothing READY is above the running task threshold */
+        return;
+    }
+#endif
     else if (RK_gSchLock == 0U)
     {
         kPendCtxSwtchNow_();
@@ -143,6 +203,30 @@ static inline RK_BOOL kReadyBitmaskTracksPrio_(RK_PRIO prio)
     return ((RK_BOOL)(prio < readyBitmaskPrioLimit));
 }
 
+#ifdef RK_READY_BITMAP_GROUPS
+static inline VOID kReadyBitmaskSet_(RK_PRIO prio)
+{
+    if (kReadyBitmaskTracksPrio_(prio) == RK_TRUE)
+    {
+        ULONG const group = (ULONG)prio >> 5U;
+        RK_gReadyGroupBitmask[group] |= 1UL << (prio & 31U);
+        RK_gReadyBitmask |= 1UL << group;
+    }
+}
+
+static inline VOID kReadyBitmaskClear_(RK_PRIO prio)
+{
+    if (kReadyBitmaskTracksPrio_(prio) == RK_TRUE)
+    {
+        ULONG const group = (ULONG)prio >> 5U;
+        RK_gReadyGroupBitmask[group] &= ~(1UL << (prio & 31U));
+        if (RK_gReadyGroupBitmask[group] == 0UL)
+        {
+            RK_gReadyBitmask &= ~(1UL << group);
+        }
+    }
+}
+#else
 static inline VOID kReadyBitmaskSet_(RK_PRIO prio)
 {
     if (kReadyBitmaskTracksPrio_(prio) == RK_TRUE)
@@ -158,6 +242,85 @@ static inline VOID kReadyBitmaskClear_(RK_PRIO prio)
         RK_gReadyBitmask &= ~(1UL << prio);
     }
 }
+#endif
+
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+/* index of the most significant bit of a non-zero mask */
+static inline ULONG kPrioIndexMsb_(ULONG mask)
+{
+#if (RK_CONF_ARMV6M == ON)
+    /* the De Bruijn lookup wants a single bit: keep the top one */
+    mask |= mask >> 1U;
+    mask |= mask >> 2U;
+    mask |= mask >> 4U;
+    mask |= mask >> 8U;
+    mask |= mask >> 16U;
+    mask ^= mask >> 1U;
+#endif
+    return ((ULONG)__getReadyPrio(mask));
+}
+
+/* last node of the numerically greatest priority <= prio that has waiters;
+the list dummy if none, so the new node goes to the head */
+static RK_NODE *kPrioIndexPred_(RK_TCBQ *const kobj, RK_PRIO const prio)
+{
+    RK_PRIO_INDEX *const idxPtr = kobj->prioIdxPtr;
+    ULONG word = (ULONG)prio >> 5U;
+    ULONG mask = idxPtr->prioBitmask[word] & ((2UL << (prio & 31U)) - 1UL);
+
+    while ((mask == 0UL) && (word > 0UL))
+    {
+        word -= 1UL;
+        mask = idxPtr->prioBitmask[word];
+    }
+
+    if (mask == 0UL)
+    {
+        return (&kobj->listDummy);
+    }
+
+    return (idxPtr->tailPtr[(word << 5U) + kPrioIndexMsb_(mask)]);
+}
+
+/* drops a node from its priority sublist, before it leaves the queue */
+static inline VOID kPrioIndexUnlink_(RK_TCBQ *const kobj,
+                                     RK_NODE *const nodePtr)
+{
+    RK_PRIO_INDEX *const idxPtr = kobj->prioIdxPtr;
+    RK_PRIO const prio = K_GET_TCB_ADDR(nodePtr)->waitQPrio;
+
+    if (idxPtr->tailPtr[prio] != nodePtr)
+    {
+        return;
+    }
+
+    RK_NODE *const prevPtr = nodePtr->prevPtr;
+    if ((prevPtr != &kobj->listDummy) &&
+        (K_GET_TCB_ADDR(prevPtr)->waitQPrio == prio))
+    {
+        idxPtr->tailPtr[prio] = prevPtr;
+    }
+    else
+    {
+        idxPtr->tailPtr[prio] = NULL;
+        idxPtr->prioBitmask[prio >> 5U] &= ~(1UL << (prio & 31U));
+    }
+}
+
+/* attaches a priority index to an empty waiting queue; from then on the
+queue must only be fed by kTCBQEnqByPrio() */
+RK_ERR kTCBQPrioIndexInit(RK_TCBQ *const kobj, RK_PRIO_INDEX *const idxPtr)
+{
+    if ((kobj == NULL) || (idxPtr == NULL))
+    {
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    RK_MEMSET(idxPtr, 0, sizeof(RK_PRIO_INDEX));
+    kobj->prioIdxPtr = idxPtr;
+    return (RK_ERR_SUCCESS);
+}
+#endif
 
 RK_ERR kTCBQInit(RK_TCBQ *const kobj)
 {
@@ -167,8 +330,58 @@ RK_ERR kTCBQInit(RK_TCBQ *const kobj)
     return (err);
 }
 
+#if (RK_CONF_EDF == ON)
+/* RK_TRUE if task A must run before task B; no deadline sorts last */
+static inline RK_BOOL kEdfBefore_(RK_TCB const *const aPtr,
+                                  RK_TCB const *const bPtr)
+{
+    if (aPtr->relDeadline == 0UL)
+    {
+        return (RK_FALSE);
+    }
+    if (bPtr->relDeadline == 0UL)
+    {
+        return (RK_TRUE);
+    }
+    return (K_TICK_IS_BEFORE(aPtr->absDeadline, bPtr->absDeadline) ? RK_TRUE
+                                                                  : RK_FALSE);
+}
+
+/* the EDF band ready queue is kept in deadline order; a jammed (preempted)
+task goes ahead of equal deadlines, an enqueued one behind them */
+static RK_ERR kEdfEnq_(RK_TCBQ *const kobj, RK_TCB *const tcbPtr,
+                       RK_BOOL const jam)
+{
+    RK_NODE *currNodePtr = &(kobj->listDummy);
+
+    while (currNodePtr->nextPtr != &(kobj->listDummy))
+    {
+        RK_TCB const *currTcbPtr = K_GET_TCB_ADDR(currNodePtr->nextPtr);
+        RK_BOOL const stop = (jam == RK_TRUE)
+                                 ? (kEdfBefore_(currTcbPtr, tcbPtr) == RK_FALSE)
+                                 : kEdfBefore_(tcbPtr, currTcbPtr);
+        if (stop)
+        {
+            break;
+        }
+        currNodePtr = currNodePtr->nextPtr;
+    }
+
+    return (kListInsertAfter(kobj, currNodePtr, &(tcbPtr->tcbNode)));
+}
+#endif
+
 RK_ERR kTCBQEnq(RK_TCBQ *const kobj, RK_TCB *const tcbPtr)
 {
+#if (RK_CONF_EDF == ON)
+    if ((tcbPtr->priority == RK_CONF_EDF_PRIO) &&
+        (kobj == &RK_gReadyQueue[RK_CONF_EDF_PRIO]))
+    {
+        RK_ERR const edfErr = kEdfEnq_(kobj, tcbPtr, RK_FALSE);
+        kReadyBitmaskSet_(tcbPtr->priority);
+        return (edfErr);
+    }
+#endif
 
     RK_ERR err = kListAddTail(kobj, &(tcbPtr->tcbNode));
     if (kobj == &RK_gReadyQueue[tcbPtr->priority])
@@ -181,6 +394,16 @@ RK_ERR kTCBQEnq(RK_TCBQ *const kobj, RK_TCB *const tcbPtr)
 
 RK_ERR kTCBQJam(RK_TCBQ *const kobj, RK_TCB *const tcbPtr)
 {
+#if (RK_CONF_EDF == ON)
+    if ((tcbPtr->priority == RK_CONF_EDF_PRIO) &&
+        (kobj == &RK_gReadyQueue[RK_CONF_EDF_PRIO]))
+    {
+        RK_ERR const edfErr = kEdfEnq_(kobj, tcbPtr, RK_TRUE);
+        kReadyBitmaskSet_(tcbPtr->priority);
+        RK_DMB
+        return (edfErr);
+    }
+#endif
 
     RK_ERR err = kListAddHead(kobj, &(tcbPtr->tcbNode));
     if (kobj == &RK_gReadyQueue[tcbPtr->priority])
@@ -194,6 +417,12 @@ RK_ERR kTCBQJam(RK_TCBQ *const kobj, RK_TCB *const tcbPtr)
 RK_ERR kTCBQDeq(RK_TCBQ *const kobj, RK_TCB **const tcbPPtr)
 {
     RK_NODE *dequeuedNodePtr = NULL;
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    if ((kobj->prioIdxPtr != NULL) && (kobj->size > 0UL))
+    {
+        kPrioIndexUnlink_(kobj, kobj->listDummy.nextPtr);
+    }
+#endif
     RK_ERR err = kListRemoveHead(kobj, &dequeuedNodePtr);
     *tcbPPtr = K_GET_TCB_ADDR(dequeuedNodePtr);
     K_ASSERT(*tcbPPtr != NULL);
@@ -210,6 +439,12 @@ RK_ERR kTCBQDeq(RK_TCBQ *const kobj, RK_TCB **const tcbPPtr)
 RK_ERR kTCBQRem(RK_TCBQ *const kobj, RK_TCB **const tcbPPtr)
 {
     RK_NODE *dequeuedNodePtr = &((*tcbPPtr)->tcbNode);
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    if (kobj->prioIdxPtr != NULL)
+    {
+        kPrioIndexUnlink_(kobj, dequeuedNodePtr);
+    }
+#endif
     kListRemove(kobj, dequeuedNodePtr);
     *tcbPPtr = K_GET_TCB_ADDR(dequeuedNodePtr);
     RK_TCB const *tcbPtr_ = *tcbPPtr;
@@ -231,6 +466,18 @@ RK_TCB *kTCBQPeek(RK_TCBQ *const kobj)
 
 RK_ERR kTCBQEnqByPrio(RK_TCBQ *const kobj, RK_TCB *const tcbPtr)
 {
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    if (kobj->prioIdxPtr != NULL)
+    {
+        RK_PRIO const prio = tcbPtr->priority;
+        RK_ERR const idxErr = kListInsertAfter(
+            kobj, kPrioIndexPred_(kobj, prio), &(tcbPtr->tcbNode));
+        tcbPtr->waitQPrio = prio;
+        kobj->prioIdxPtr->tailPtr[prio] = &(tcbPtr->tcbNode);
+        kobj->prioIdxPtr->prioBitmask[prio >> 5U] |= 1UL << (prio & 31U);
+        return (idxErr);
+    }
+#endif
     RK_NODE *currNodePtr = &(kobj->listDummy);
 
     while (currNodePtr->nextPtr != &(kobj->listDummy))
@@ -253,7 +500,20 @@ scheduler lock state */
 RK_ERR kReschedTask(RK_TCB *tcbPtr)
 {
 
-    if ((RK_gRunPtr->priority > tcbPtr->priority) && RK_gRunPtr->preempt == 1UL)
+    RK_BOOL preempts = (kRunPreemptLevel_() > tcbPtr->priority) ? RK_TRUE
+                                                                 : RK_FALSE;
+#if (RK_CONF_EDF == ON)
+    /* inside the band, an earlier deadline preempts */
+    if ((tcbPtr->priority == RK_CONF_EDF_PRIO) &&
+        (RK_gRunPtr->priority == RK_CONF_EDF_PRIO) &&
+        (kRunPreemptLevel_() == RK_CONF_EDF_PRIO) &&
+        (RK_gRunPtr->status == RK_RUNNING) &&
+        (kEdfBefore_(tcbPtr, RK_gRunPtr) == RK_TRUE))
+    {
+        preempts = RK_TRUE;
+    }
+#endif
+    if ((preempts == RK_TRUE) && RK_gRunPtr->preempt == 1UL)
     {
         if (RK_gSchLock == 0UL)
         {
@@ -276,7 +536,7 @@ RK_ERR kReschedRunning(VOID)
     RK_PRIO const readyPrio = kCalcNextTaskPrio_();
 
     if ((RK_gRunPtr != NULL) && (RK_gRunPtr->status == RK_RUNNING) &&
-        (RK_gRunPtr->preempt == 1UL) && (readyPrio < RK_gRunPtr->priority))
+        (RK_gRunPtr->preempt == 1UL) && (readyPrio < kRunPreemptLevel_()))
     {
         kPendCtxSwtch();
         if (RK_gSchLock != 0UL)
@@ -294,7 +554,89 @@ static inline RK_PRIO kTaskMinPrio_(RK_PRIO const currentPrio,
     return ((candidatePrio < currentPrio) ? candidatePrio : currentPrio);
 }
 
+#if (RK_CONF_PRIO_CONTRIB == ON)
+/*
+ * Boosts are reference counted per priority level, so a task owning many
+ * messages from one ceiling pool holds a single bit set. Adding or dropping a
+ * boost is O(1); reading the highest one costs one word per 32 levels.
+ */
+VOID kTaskPrioContribAdd(RK_TCB *const taskPtr, RK_PRIO const prio)
+{
+    if (taskPtr->prioContribCnt[prio] == 0U)
+    {
+        taskPtr->prioContribMask[prio >> 5U] |= 1UL << (prio & 31U);
+    }
+    taskPtr->prioContribCnt[prio] += 1U;
+}
+
+VOID kTaskPrioContribRem(RK_TCB *const taskPtr, RK_PRIO const prio)
+{
+    K_ASSERT(taskPtr->prioContribCnt[prio] > 0U);
+    taskPtr->prioContribCnt[prio] -= 1U;
+    if (taskPtr->prioContribCnt[prio] == 0U)
+    {
+        taskPtr->prioContribMask[prio >> 5U] &= ~(1UL << (prio & 31U));
+    }
+}
+
+static inline RK_PRIO kTaskPrioContribTop_(RK_TCB const *const taskPtr,
+                                           RK_PRIO const currentPrio)
+{
+    for (ULONG word = 0UL; word < RK_PRIO_CONTRIB_WORDS; word++)
+    {
+        ULONG const mask = taskPtr->prioContribMask[word];
+        if (mask != 0UL)
+        {
+            /* lowest set bit is the highest priority boost */
+            RK_PRIO const prio =
+                (RK_PRIO)((word << 5U) +
+                          (ULONG)__getReadyPrio(mask & (~mask + 1UL)));
+            return (kTaskMinPrio_(currentPrio, prio));
+        }
+    }
+    return (currentPrio);
+}
+
 #if (RK_CONF_MUTEX == ON)
+/*
+ * Moves the inheritance boost of a mutex to match its current state: an
+ * inheritance mutex with waiters boosts its owner to the head waiter's
+ * priority. Called after the owner, the waiting queue or the head waiter
+ * priority changed; the caller then updates the affected owners.
+ */
+VOID kMutexPrioContribSync(RK_MUTEX *const mtxPtr)
+{
+    RK_TCB *taskPtr = NULL;
+    RK_PRIO prio = 0U;
+
+    if ((mtxPtr->protocol == RK_PRIO_INHERITANCE) &&
+        (mtxPtr->ownerPtr != NULL) && (mtxPtr->waitingQueue.size > 0UL))
+    {
+        taskPtr = mtxPtr->ownerPtr;
+        prio = kTCBQPeek(&mtxPtr->waitingQueue)->priority;
+    }
+
+    if ((taskPtr == mtxPtr->contribTaskPtr) &&
+        ((taskPtr == NULL) || (prio == mtxPtr->contribPrio)))
+    {
+        return;
+    }
+
+    if (mtxPtr->contribTaskPtr != NULL)
+    {
+        kTaskPrioContribRem(mtxPtr->contribTaskPtr, mtxPtr->contribPrio);
+    }
+    if (taskPtr != NULL)
+    {
+        kTaskPrioContribAdd(taskPtr, prio);
+    }
+    mtxPtr->contribTaskPtr = taskPtr;
+    mtxPtr->contribPrio = prio;
+}
+#endif
+#endif
+
+#if ((RK_CONF_MUTEX == ON) && (RK_CONF_PRIO_CONTRIB == OFF))
 static RK_PRIO kTaskOwnedMutexPipPrio_(RK_TCB *const ownerTcb,
                                        RK_PRIO const currentPrio)
 {
@@ -358,7 +700,8 @@ static RK_PRIO kTaskSynchMesgPrio_(RK_TCB *const taskPtr,
 }
 #endif
 
-#if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON))
+#if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON) && \
+     (RK_CONF_PRIO_CONTRIB == OFF))
 /*
  * Apply the asynchronous-message priority ceiling. Each owned message points
  * back to its pool, and each pool may contribute one ceiling. Lower numeric
@@ -405,7 +748,21 @@ static RK_PRIO kTaskCalcEffectivePrio_(RK_TCB *const taskPtr)
 {
     RK_PRIO newPrio = taskPtr->prioNominal;
 
-#if (RK_CONF_MUTEX == ON)
+#if (RK_CONF_CPU_BUDGET == ON)
+    /* An exhausted budget lowers the base the boosts apply to. */
+    if ((taskPtr->budgetExhausted == RK_TRUE) &&
+        (taskPtr->budgetBgPrio > newPrio))
+    {
+        newPrio = taskPtr->budgetBgPrio;
+    }
+#endif
+
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    /* Inheritance and ceiling boosts are kept up to date as they change. */
+    newPrio = kTaskPrioContribTop_(taskPtr, newPrio);
+#endif
+
+#if ((RK_CONF_MUTEX == ON) && (RK_CONF_PRIO_CONTRIB == OFF))
     /* Mutex priority inheritance can raise an owner to its highest waiter. */
     newPrio = kTaskOwnedMutexPipPrio_(taskPtr, newPrio);
 #endif
@@ -415,7 +772,8 @@ static RK_PRIO kTaskCalcEffectivePrio_(RK_TCB *const taskPtr)
     newPrio = kTaskSynchMesgPrio_(taskPtr, newPrio);
 #endif
 
-#if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON))
+#if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON) && \
+     (RK_CONF_PRIO_CONTRIB == OFF))
     /*
      * Message ceilings are ownership-based: kMesgSetOwner_() maintains the
      * owned-message list, and this hook folds those ceilings into scheduling.
@@ -430,13 +788,23 @@ static VOID kTaskRequeueWaiterByPrio_(RK_TCB *const tcbPtr)
 {
     RK_LIST *const waitQueuePtr = tcbPtr->timeoutNode.waitingQueuePtr;
 
-    if ((waitQueuePtr == NULL) || (waitQueuePtr->size <= 1UL) ||
-        (tcbPtr->tcbNode.nextPtr == NULL) ||
+    if ((waitQueuePtr == NULL) || (tcbPtr->tcbNode.nextPtr == NULL) ||
         (tcbPtr->tcbNode.prevPtr == NULL))
     {
         return;
     }
 
+    /* a lone waiter has nothing to overtake, unless the queue is indexed:
+    its sublist slot and bitmask bit still carry the old priority */
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    if ((waitQueuePtr->size <= 1UL) && (waitQueuePtr->prioIdxPtr == NULL))
+#else
+    if (waitQueuePtr->size <= 1UL)
+#endif
+    {
+        return;
+    }
+
     RK_TCB *requeuePtr = tcbPtr;
     RK_ERR err = kTCBQRem(waitQueuePtr, &requeuePtr);
     K_ASSERT(err == RK_ERR_SUCCESS);
@@ -460,6 +828,16 @@ RK_BOOL kTaskUpdateEffectivePrio(RK_TCB *const tcbPtr)
 
     RK_PRIO const oldPrio = tcbPtr->priority;
 
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+    if (tcbPtr == RK_gHandoffPtr)
+    {
+        /* READY but not queued: kSwtch() checks it against the bitmap */
+        tcbPtr->priority = newPrio;
+        kTraceRecordTaskPrio(tcbPtr, oldPrio, newPrio);
+        return (RK_TRUE);
+    }
+#endif
+
     if (tcbPtr->status == RK_READY)
     {
         RK_TCB *remPtr = tcbPtr;
@@ -523,6 +901,11 @@ VOID kTaskUpdateEffectivePrioChain(RK_TCB *const tcbPtr)
             break;
         }
 
+#if (RK_CONF_PRIO_CONTRIB == ON)
+        /* the requeue may have changed the head waiter */
+        kMutexPrioContribSync(waitMtxPtr);
+#endif
+
         currTcbPtr = waitMtxPtr->ownerPtr;
 #else
         break;
@@ -532,6 +915,41 @@ VOID kTaskUpdateEffectivePrioChain(RK_TCB *const tcbPtr)
     RK_ISB
 }
 
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+/* readies a task and, if nothing READY is above it and it beats the
+running task (or the running task is leaving), makes it the next to run */
+RK_ERR kReadyHandoff(RK_TCB *const tcbPtr)
+{
+    if ((RK_gHandoffPtr == NULL) && (RK_gSchLock == 0UL) &&
+        (tcbPtr->tid != RK_POSTPROC_TASK_ID) &&
+        ((RK_gRunPtr->status != RK_RUNNING) ||
+         ((RK_gRunPtr->preempt == 1UL) &&
+          (tcbPtr->priority < kRunPreemptLevel_()))) &&
+        ((RK_gReadyBitmask == 0UL) ||
+         (tcbPtr->priority < kCalcNextTaskPrio_())))
+    {
+        tcbPtr->status = RK_READY;
+        RK_gHandoffPtr = tcbPtr;
+        kPendCtxSwtchNow_();
+        return (RK_ERR_SUCCESS);
+    }
+    return (kReadySwtch(tcbPtr));
+}
+
+/* puts a pending handoff target back on its ready queue, for the paths
+that take a READY task to be queued; the pended switch still runs */
+VOID kReadyHandoffUndo(RK_TCB *const tcbPtr)
+{
+    if ((tcbPtr != NULL) && (tcbPtr == RK_gHandoffPtr))
+    {
+        RK_gHandoffPtr = NULL;
+        RK_ERR err = kTCBQEnq(&RK_gReadyQueue[tcbPtr->priority], tcbPtr);
+        K_ASSERT(err == RK_ERR_SUCCESS);
+        K_UNUSE(err);
+    }
+}
+#endif
+
 RK_ERR kReadySwtch(RK_TCB *const tcbPtr)
 {
     RK_ERR err = -1;
@@ -649,6 +1067,13 @@ static RK_ERR kTaskPoolInit_(ULONG const nTcbs)
 
     RK_ERR err =
         kMemPartitionInit(&RK_gTaskPool, RK_gTcbs, sizeof(RK_TCB), nTcbs);
+#if (RK_CONF_ERR_CHECK == ON)
+    if (err == RK_ERR_SUCCESS)
+    {
+        err = kMemPartitionAttachMap(&RK_gTaskPool, RK_gTcbMap,
+                                     RK_MEM_POOL_MAP_WORDS(RK_NTHREADS));
+    }
+#endif
     if (err == RK_ERR_SUCCESS)
     {
         kTraceNameObject(&RK_gTaskPool, "TCBPool");
@@ -678,7 +1103,29 @@ static RK_ERR kTaskInitTcb_(RK_TCB *const tcbPtr, RK_TID const tid,
     tcbPtr->wakeTime = 0UL;
     tcbPtr->overrunCount = 0UL;
     tcbPtr->init = RK_TRUE;
+#if (RK_CONF_TIME_SLICE == ON)
+    tcbPtr->timeSlice = RK_CONF_TIME_SLICE_TICKS;
+    tcbPtr->timeSliceLeft = 0UL;
+#endif
+#if (RK_CONF_CPU_BUDGET == ON)
+    tcbPtr->budget = 0UL;
+    tcbPtr->budgetLeft = 0UL;
+    tcbPtr->budgetPeriod = 0UL;
+    tcbPtr->budgetReplenish = 0UL;
+    tcbPtr->budgetArmed = RK_FALSE;
+    tcbPtr->budgetExhausted = RK_FALSE;
+    tcbPtr->budgetBgPrio = 0U;
+#endif
+#if (RK_CONF_EDF == ON)
+    tcbPtr->relDeadline = 0UL;
+    tcbPtr->absDeadline = 0UL;
+#endif
+#if (RK_CONF_PRIO_CONTRIB == ON)
+    RK_MEMSET(tcbPtr->prioContribCnt, 0, sizeof(tcbPtr->prioContribCnt));
+    RK_MEMSET(tcbPtr->prioContribMask, 0, sizeof(tcbPtr->prioContribMask));
+#endif
 
+    tcbPtr->memAllocBlockPtr = NULL;
 #if (RK_CONF_MESG_QUEUE == ON)
     tcbPtr->mesgQueueRecvBufPtr = NULL;
 #endif
@@ -752,6 +1199,9 @@ kTaskCreateFromPool_(RK_TASK_HANDLE *taskHandlePtr, RK_TASKENTRY const taskFunc,
 
     newTcbPtr->priority = priority;
     newTcbPtr->prioNominal = priority;
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+    newTcbPtr->preemptThreshold = priority;
+#endif
     newTcbPtr->preempt = preempt;
     kWriteTaskName_(newTcbPtr, taskName);
 
@@ -773,6 +1223,9 @@ kTaskCreateFromPool_(RK_TASK_HANDLE *taskHandlePtr, RK_TASKENTRY const taskFunc,
 
     RK_gTaskHandleByPid[tid] = newTcbPtr;
     RK_gTaskDynStackPartByPid[tid] = NULL;
+#if (RK_CONF_HEAP == ON)
+    RK_gTaskDynStackHeapByPid[tid] = NULL;
+#endif
 
     return (RK_ERR_SUCCESS);
 }
@@ -941,6 +1394,24 @@ RK_ERR kTaskInit(RK_TASK_HANDLE *taskHandlePtr, const RK_TASKENTRY taskFunc,
 
             return (err);
         }
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+        for (UINT i = 0U; i < RK_N_TIMER_BAND_TASKS; i++)
+        {
+            err = kTaskCreateFromPool_
+            (
+                &RK_gTimerBandTaskHandle[i], TimerBandSysTask,
+                (VOID *)kTimerBandList(i + 1U), "TmrBand",
+                RK_gTimerBandStack[i], RK_CONF_TIMER_BAND_STACKSIZE,
+                (RK_PRIO)(RK_CONF_TIMER_BAND_PRIO + i), RK_PREEMPT
+            );
+            if (err != RK_ERR_SUCCESS)
+            {
+                K_PANIC("Failed to create timer band system task");
+                RK_CR_EXIT
+                return (err);
+            }
+        }
+#endif
         /* mark system tasks as initialised */
         RK_gSystemTasksInit = RK_TRUE;
     }
@@ -958,7 +1429,8 @@ RK_ERR kTaskSpawn(RK_DYNAMIC_TASK_ATTR const *taskAttrPtr,
 {
     if ((taskAttrPtr == NULL) || (taskHandlePtr == NULL) ||
         (taskAttrPtr->taskFunc == NULL) || (taskAttrPtr->taskName == NULL) ||
-        (taskAttrPtr->stackMemPtr == NULL))
+        ((taskAttrPtr->stackMemPtr == NULL) &&
+         !K_TASK_STACK_FROM_HEAP(taskAttrPtr)))
     {
 #if (RK_CONF_ERR_CHECK == ON)
         kErrHandler(RK_FAULT_OBJ_NULL);
@@ -992,25 +1464,59 @@ RK_ERR kTaskSpawn(RK_DYNAMIC_TASK_ATTR const *taskAttrPtr,
     }
 
     RK_MEM_PARTITION *stackMemPtr = taskAttrPtr->stackMemPtr;
-    if ((stackMemPtr->objID != RK_MEMALLOC_KOBJ_ID) ||
-        (stackMemPtr->init != RK_TRUE))
-    {
+    RK_STACK *stackBufPtr = NULL;
+    ULONG stackSize = 0UL;
+#if (RK_CONF_HEAP == ON)
+    RK_HEAP *stackHeapPtr = NULL;
+    if (K_TASK_STACK_FROM_HEAP(taskAttrPtr))
+    {
+        stackHeapPtr = taskAttrPtr->stackHeapPtr;
+        if ((stackHeapPtr->objID != RK_HEAP_KOBJ_ID) ||
+            (stackHeapPtr->init != RK_TRUE))
+        {
 #if (RK_CONF_ERR_CHECK == ON)
-        kErrHandler(RK_FAULT_INVALID_OBJ);
+            kErrHandler(RK_FAULT_INVALID_OBJ);
 #endif
-        return (RK_ERR_INVALID_OBJ);
-    }
+            return (RK_ERR_INVALID_OBJ);
+        }
 
-    ULONG const stackSize = (stackMemPtr->blkSize / RK_WORD_SIZE);
-    if ((stackSize < RK_MIN_STACKSIZE) || ((stackSize & 1U) != 0U))
-    {
+        stackSize = taskAttrPtr->stackSize;
+        if ((stackSize < RK_MIN_STACKSIZE) || ((stackSize & 1U) != 0U) ||
+            (stackSize > (RK_ULONG_MAX / RK_WORD_SIZE)))
+        {
 #if (RK_CONF_ERR_CHECK == ON)
-        kErrHandler(RK_FAULT_INVALID_PARAM);
+            kErrHandler(RK_FAULT_INVALID_PARAM);
 #endif
-        return (RK_ERR_INVALID_PARAM);
+            return (RK_ERR_INVALID_PARAM);
+        }
+
+        /* heap blocks are 8-byte aligned, as the AAPCS wants a stack */
+        stackBufPtr =
+            (RK_STACK *)kHeapAlloc(stackHeapPtr, stackSize * RK_WORD_SIZE);
     }
+    else
+#endif
+    {
+        if ((stackMemPtr->objID != RK_MEMALLOC_KOBJ_ID) ||
+            (stackMemPtr->init != RK_TRUE))
+        {
+#if (RK_CONF_ERR_CHECK == ON)
+            kErrHandler(RK_FAULT_INVALID_OBJ);
+#endif
+            return (RK_ERR_INVALID_OBJ);
+        }
+
+        stackSize = (stackMemPtr->blkSize / RK_WORD_SIZE);
+        if ((stackSize < RK_MIN_STACKSIZE) || ((stackSize & 1U) != 0U))
+        {
+#if (RK_CONF_ERR_CHECK == ON)
+            kErrHandler(RK_FAULT_INVALID_PARAM);
+#endif
+            return (RK_ERR_INVALID_PARAM);
+        }
 
-    RK_STACK *stackBufPtr = (RK_STACK *)kMemPartitionAlloc(stackMemPtr);
+        stackBufPtr = (RK_STACK *)kMemPartitionAlloc(stackMemPtr);
+    }
     if (stackBufPtr == NULL)
     {
         return (RK_ERR_TASK_POOL_EMPTY);
@@ -1043,6 +1549,9 @@ RK_ERR kTaskSpawn(RK_DYNAMIC_TASK_ATTR const *taskAttrPtr,
         else
         {
             RK_gTaskDynStackPartByPid[tid] = stackMemPtr;
+#if (RK_CONF_HEAP == ON)
+            RK_gTaskDynStackHeapByPid[tid] = stackHeapPtr;
+#endif
         }
     }
 
@@ -1053,7 +1562,16 @@ RK_ERR kTaskSpawn(RK_DYNAMIC_TASK_ATTR const *taskAttrPtr,
 
     if (err != RK_ERR_SUCCESS)
     {
-        kMemPartitionFree(stackMemPtr, stackBufPtr);
+#if (RK_CONF_HEAP == ON)
+        if (stackHeapPtr != NULL)
+        {
+            kHeapFree(stackHeapPtr, stackBufPtr);
+        }
+        else
+#endif
+        {
+            kMemPartitionFree(stackMemPtr, stackBufPtr);
+        }
     }
     return (err);
 }
@@ -1129,7 +1647,12 @@ RK_ERR kTaskTerminate(RK_TASK_HANDLE *taskHandlePtr)
     }
 
     /* Only runtime-spawned tasks are terminable. */
+#if (RK_CONF_HEAP == ON)
+    if ((RK_gTaskDynStackPartByPid[taskPid] == NULL) &&
+        (RK_gTaskDynStackHeapByPid[taskPid] == NULL))
+#else
     if (RK_gTaskDynStackPartByPid[taskPid] == NULL)
+#endif
     {
 #if (RK_CONF_ERR_CHECK == ON)
         kErrHandler(RK_FAULT_INVALID_OBJ);
@@ -1190,6 +1713,9 @@ RK_ERR kTaskTerminate(RK_TASK_HANDLE *taskHandlePtr)
     switch (taskPtr->status)
     {
         case RK_READY:
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+            kReadyHandoffUndo(taskPtr);
+#endif
             if ((taskPtr->tcbNode.nextPtr != NULL) &&
                 (taskPtr->tcbNode.prevPtr != NULL))
             {
@@ -1211,6 +1737,12 @@ RK_ERR kTaskTerminate(RK_TASK_HANDLE *taskHandlePtr)
                     return (err);
                 }
             }
+#if (RK_CONF_HRTIMER == ON)
+            if (taskPtr->status == RK_SLEEPING_DELAY)
+            {
+                kHrTimerCancelTask(taskPtr);
+            }
+#endif
             break;
 
         case RK_PENDING: /* deferred self-termination path */
@@ -1262,6 +1794,9 @@ RK_ERR kTaskTerminate(RK_TASK_HANDLE *taskHandlePtr)
     RK_TID const slotPid = taskPid;
     RK_STACK *stackBufPtr = NULL;
     RK_MEM_PARTITION *stackMemPtr = NULL;
+#if (RK_CONF_HEAP == ON)
+    RK_HEAP *stackHeapPtr = NULL;
+#endif
     if (slotPid < RK_NTHREADS)
     {
         stackMemPtr = RK_gTaskDynStackPartByPid[slotPid];
@@ -1269,7 +1804,14 @@ RK_ERR kTaskTerminate(RK_TASK_HANDLE *taskHandlePtr)
         {
             stackBufPtr = taskPtr->stackBufPtr;
         }
-    }
+#if (RK_CONF_HEAP == ON)
+        stackHeapPtr = RK_gTaskDynStackHeapByPid[slotPid];
+        if (stackHeapPtr != NULL)
+        {
+            stackBufPtr = taskPtr->stackBufPtr;
+        }
+#endif
+    }
 
     RK_MEMSET(taskPtr, 0, sizeof(RK_TCB));
     RK_ERR err = kMemPartitionFree(&RK_gTaskPool, taskPtr);
@@ -1283,6 +1825,17 @@ RK_ERR kTaskTerminate(RK_TASK_HANDLE *taskHandlePtr)
                 K_PANIC("Failed to free task spawn stack block");
             }
         }
+#if (RK_CONF_HEAP == ON)
+        if ((stackBufPtr != NULL) && (stackHeapPtr != NULL))
+        {
+            RK_ERR stackErr = kHeapFree(stackHeapPtr, stackBufPtr);
+            if (stackErr != RK_ERR_SUCCESS)
+            {
+                K_PANIC("Failed to free task spawn stack block");
+            }
+        }
+        RK_gTaskDynStackHeapByPid[slotPid] = NULL;
+#endif
 
         RK_gTaskDynStackPartByPid[slotPid] = NULL;
         RK_gTaskHandleByPid[slotPid] = NULL;
@@ -1341,6 +1894,223 @@ RK_PRIO kTaskGetPrio(RK_TASK_HANDLE taskHandle)
     return (taskHandle->priority);
 }
 
+#if (RK_CONF_TIME_SLICE == ON)
+RK_ERR kTaskSetTimeSlice(RK_TASK_HANDLE const taskHandle, RK_TICK const ticks)
+{
+    if (taskHandle == NULL)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    if (taskHandle->init != RK_TRUE)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+#endif
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+    if (ticks > RK_MAX_PERIOD)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    taskHandle->timeSlice = ticks;
+    /* a new quantum takes effect from now on for the running task */
+    taskHandle->timeSliceLeft = (taskHandle == RK_gRunPtr) ? ticks : 0UL;
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+#endif
+
+#if (RK_CONF_CPU_BUDGET == ON)
+RK_ERR kTaskSetBudget(RK_TASK_HANDLE const taskHandle, RK_TICK const budget,
+                      RK_TICK const period, RK_PRIO const bgPrio)
+{
+    if (taskHandle == NULL)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    if (taskHandle->init != RK_TRUE)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+#endif
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+    if ((budget != 0UL) &&
+        ((period < budget) || (period > RK_MAX_PERIOD)))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    if ((budget != 0UL) && ((bgPrio < taskHandle->prioNominal) ||
+                            (bgPrio > RK_CONF_MIN_PRIO)))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_TASK_INVALID_PRIO);
+#endif
+        return (RK_ERR_INVALID_PRIO);
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    taskHandle->budget = budget;
+    taskHandle->budgetLeft = budget;
+    taskHandle->budgetPeriod = period;
+    taskHandle->budgetBgPrio = bgPrio;
+    /* a pending replenishment is dropped by the next scan */
+    taskHandle->budgetArmed = RK_FALSE;
+    if (taskHandle->budgetExhausted == RK_TRUE)
+    {
+        taskHandle->budgetExhausted = RK_FALSE;
+        kTaskUpdateEffectivePrioChain(taskHandle);
+    }
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+#endif
+
+#if (RK_CONF_EDF == ON)
+/* a deadline of the RUNNING task moved: an EDF peer may now be first */
+static VOID kEdfReschedRunning_(VOID)
+{
+    RK_TCBQ *const bandPtr = &RK_gReadyQueue[RK_CONF_EDF_PRIO];
+
+    if ((RK_gRunPtr->status == RK_RUNNING) &&
+        (RK_gRunPtr->priority == RK_CONF_EDF_PRIO) &&
+        (RK_gRunPtr->preempt == 1UL) && (bandPtr->size > 0UL) &&
+        (kEdfBefore_(kTCBQPeek(bandPtr), RK_gRunPtr) == RK_TRUE))
+    {
+        kPendCtxSwtch();
+    }
+}
+
+/* a job of the task is released at releaseTick */
+VOID kTaskDeadlineRelease(RK_TCB *const tcbPtr, RK_TICK const releaseTick)
+{
+    if (tcbPtr->relDeadline == 0UL)
+    {
+        return;
+    }
+    tcbPtr->absDeadline = K_TICK_ADD(releaseTick, tcbPtr->relDeadline);
+    if (tcbPtr == RK_gRunPtr)
+    {
+        kEdfReschedRunning_();
+    }
+}
+
+RK_ERR kTaskSetDeadline(RK_TASK_HANDLE const taskHandle, RK_TICK const ticks)
+{
+    if (taskHandle == NULL)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    if (taskHandle->init != RK_TRUE)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+#endif
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+    if (ticks > RK_MAX_PERIOD)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    taskHandle->relDeadline = ticks;
+    taskHandle->absDeadline = K_TICK_ADD(kTickGet(), ticks);
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+    kReadyHandoffUndo(taskHandle);
+#endif
+    if ((taskHandle->status == RK_READY) &&
+        (taskHandle->priority == RK_CONF_EDF_PRIO))
+    {
+        /* keep the band sorted */
+        RK_TCB *requeuePtr = taskHandle;
+        kTCBQRem(&RK_gReadyQueue[RK_CONF_EDF_PRIO], &requeuePtr);
+        kTCBQEnq(&RK_gReadyQueue[RK_CONF_EDF_PRIO], requeuePtr);
+        if (RK_gRunPtr != NULL)
+        {
+            kReschedTask(requeuePtr);
+        }
+    }
+    else if ((taskHandle == RK_gRunPtr) && (RK_gRunPtr != NULL))
+    {
+        kEdfReschedRunning_();
+    }
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+#endif
+
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+RK_ERR kTaskSetPreemptThreshold(RK_TASK_HANDLE const taskHandle,
+                                RK_PRIO const threshold)
+{
+    if (taskHandle == NULL)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        return (RK_ERR_OBJ_NULL);
+    }
+
+    if (taskHandle->init != RK_TRUE)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+#endif
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+
+    if (threshold > taskHandle->prioNominal)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_TASK_INVALID_PRIO);
+#endif
+        return (RK_ERR_INVALID_PRIO);
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    taskHandle->preemptThreshold = threshold;
+    /* lowering the running task threshold may let a READY task in */
+    if ((taskHandle == RK_gRunPtr) && (RK_gRunPtr->status == RK_RUNNING))
+    {
+        kReschedRunning();
+    }
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+#endif
+
 /******************************************************************************/
 /* KERNEL INITIALISATION                                                      */
 /******************************************************************************/
@@ -1348,11 +2118,18 @@ static VOID kInitRunTime_(VOID)
 {
     RK_gRunTime.globalTick = 0UL;
     RK_gRunTime.nWraps = 0UL;
+    RK_gRunTime.tickSeq = 0UL;
 }
 static RK_ERR kInitQueues_(VOID)
 {
     RK_gReadyBitmask = 0U;
     RK_gReadyPos = 0U;
+#ifdef RK_READY_BITMAP_GROUPS
+    for (ULONG i = 0; i < RK_READY_BITMAP_GROUPS; i++)
+    {
+        RK_gReadyGroupBitmask[i] = 0U;
+    }
+#endif
     for (ULONG i = 0; i < (RK_CONF_MIN_PRIO + RK_N_SYSTASKS); i++)
     {
         RK_ERR err = kTCBQInit(&RK_gReadyQueue[i]);
@@ -1391,6 +2168,13 @@ VOID kInit(VOID)
         K_PANIC("FAILED TO INITIALISE TASK POOL");
     }
 
+#if (RK_CONF_MEM_ALLOC == ON)
+    if (kMemAllocInit() != RK_ERR_SUCCESS)
+    {
+        K_PANIC("FAILED TO INITIALISE SIZE-CLASS ALLOCATOR");
+    }
+#endif
+
     kApplicationInit();
 
     RK_DSB
@@ -1456,8 +2240,18 @@ static inline RK_PRIO kCalcNextTaskPrio_()
         return (idleTaskPrio);
     }
 
+#ifdef RK_READY_BITMAP_GROUPS
+    /* first the highest ready group, then the highest priority within it */
+    ULONG const groupPos = RK_gReadyBitmask & -RK_gReadyBitmask;
+    ULONG const group = (ULONG)__getReadyPrio(groupPos);
+    RK_gReadyPos =
+        RK_gReadyGroupBitmask[group] & -RK_gReadyGroupBitmask[group];
+    volatile RK_PRIO prio =
+        (RK_PRIO)((group << 5U) + __getReadyPrio(RK_gReadyPos));
+#else
     RK_gReadyPos = RK_gReadyBitmask & -RK_gReadyBitmask;
     volatile RK_PRIO prio = (RK_PRIO)(__getReadyPrio(RK_gReadyPos));
+#endif
     return (prio);
 }
 
@@ -1468,11 +2262,52 @@ VOID kSwtch(VOID)
 
     if (RK_gRunPtr->status == RK_RUNNING)
     {
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+        /* a handoff target is not on the bitmap, but was checked already */
+        if ((RK_gHandoffPtr == NULL) && (kRunThresholdHolds_() == RK_TRUE))
+#else
+        if (kRunThresholdHolds_() == RK_TRUE)
+#endif
+        {
+            return;
+        }
+#endif
         kPreemptRunningTask_();
     }
+#if (RK_CONF_TIME_SLICE == ON)
+    else if (RK_gRunPtr->status != RK_READY)
+    {
+        /* left RUNNING on its own: next dispatch gets a fresh quantum */
+        currRK_gRunPtr->timeSliceLeft = 0UL;
+    }
+#endif
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+    if (RK_gHandoffPtr != NULL)
+    {
+        nextRK_gRunPtr = RK_gHandoffPtr;
+        RK_gHandoffPtr = NULL;
+        /* an interrupt may have readied something higher meanwhile */
+        if (RK_gReadyBitmask != 0UL)
+        {
+            if (kCalcNextTaskPrio_() < nextRK_gRunPtr->priority)
+            {
+                kTCBQEnq(&RK_gReadyQueue[nextRK_gRunPtr->priority],
+                         nextRK_gRunPtr);
+                nextRK_gRunPtr = NULL;
+            }
+        }
+    }
+    if (nextRK_gRunPtr == NULL)
+    {
+        nextTaskPrio = kCalcNextTaskPrio_();
+        kTCBQDeq(&RK_gReadyQueue[nextTaskPrio], &nextRK_gRunPtr);
+    }
+#else
     nextTaskPrio = kCalcNextTaskPrio_();
 
     kTCBQDeq(&RK_gReadyQueue[nextTaskPrio], &nextRK_gRunPtr);
+#endif
 
     if (nextRK_gRunPtr == NULL)
     {
@@ -1481,6 +2316,13 @@ VOID kSwtch(VOID)
     currRK_gRunPtr->schLock = RK_gSchLock;
     RK_gRunPtr = nextRK_gRunPtr;
     RK_gSchLock = RK_gRunPtr->schLock;
+#if (RK_CONF_TIME_SLICE == ON)
+    /* a preempted task resumes what was left of its quantum */
+    if (RK_gRunPtr->timeSliceLeft == 0UL)
+    {
+        RK_gRunPtr->timeSliceLeft = RK_gRunPtr->timeSlice;
+    }
+#endif
 }
 static inline VOID kPreemptRunningTask_(VOID)
 {
@@ -1495,6 +2337,9 @@ static inline VOID kYieldRunningTask_(VOID)
     {
         kTCBQEnq(&RK_gReadyQueue[RK_gRunPtr->priority], RK_gRunPtr);
         RK_gRunPtr->status = RK_READY;
+#if (RK_CONF_TIME_SLICE == ON)
+        RK_gRunPtr->timeSliceLeft = 0UL;
+#endif
         if (RK_gSchLock == 0U)
         {
             kPendCtxSwtchNow_();
@@ -1514,11 +2359,172 @@ static inline VOID kYieldRunningTask_(VOID)
 volatile RK_TIMEOUT_NODE *RK_gTimeOutListHeadPtr = NULL;
 volatile RK_TIMEOUT_NODE *RK_gTimerListHeadPtr = NULL;
 
+/* the tick count is only written in critical sections, between these two:
+ * kTickGet64() readers retry if the sequence moved or is odd */
+static inline VOID kTickSeqBegin_(VOID)
+{
+    RK_gRunTime.tickSeq += 1UL;
+    RK_DMB
+}
+
+static inline VOID kTickSeqEnd_(VOID)
+{
+    RK_DMB
+    RK_gRunTime.tickSeq += 1UL;
+}
+
+#if (RK_CONF_TIME_SLICE == ON)
+/* charges one tick to the running task quantum; when it is exhausted and
+ * a peer of the same priority is READY, the running task goes to the tail */
+static inline RK_BOOL kTimeSliceTick_(VOID)
+{
+    RK_TCB *const runPtr = RK_gRunPtr;
+
+    if ((runPtr->status != RK_RUNNING) || (runPtr->timeSlice == 0UL) ||
+        (runPtr->preempt == RK_NO_PREEMPT))
+    {
+        return (RK_FALSE);
+    }
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+    /* peers are below a raised threshold */
+    if (kRunPreemptLevel_() < runPtr->priority)
+    {
+        return (RK_FALSE);
+    }
+#endif
+
+    if (runPtr->timeSliceLeft > 1UL)
+    {
+        runPtr->timeSliceLeft -= 1UL;
+        return (RK_FALSE);
+    }
+
+    runPtr->timeSliceLeft = runPtr->timeSlice;
+    if ((RK_gReadyQueue[runPtr->priority].size == 0UL) ||
+        (RK_gSchLock > 0UL))
+    {
+        return (RK_FALSE);
+    }
+
+    kTCBQEnq(&RK_gReadyQueue[runPtr->priority], runPtr);
+    runPtr->status = RK_READY;
+    runPtr->timeSliceLeft = 0UL;
+    return (RK_TRUE);
+}
+#endif
+
+#if (RK_CONF_CPU_BUDGET == ON)
+/* earliest armed replenishment; valid while RK_gBudgetPending is true */
+static RK_TICK RK_gBudgetNextReplenish = 0UL;
+static RK_BOOL RK_gBudgetPending = RK_FALSE;
+
+static inline VOID kBudgetArm_(RK_TCB *const taskPtr, RK_TICK const when)
+{
+    taskPtr->budgetReplenish = when;
+    taskPtr->budgetArmed = RK_TRUE;
+    if ((RK_gBudgetPending == RK_FALSE) ||
+        K_TICK_IS_BEFORE(when, RK_gBudgetNextReplenish))
+    {
+        RK_gBudgetNextReplenish = when;
+    }
+    RK_gBudgetPending = RK_TRUE;
+}
+
+/* refills every due budget; a scan only runs when one is due */
+static RK_BOOL kBudgetReplenish_(RK_TICK const now)
+{
+    RK_BOOL resched = RK_FALSE;
+
+    RK_gBudgetPending = RK_FALSE;
+    for (UINT i = 0U; i < RK_NTHREADS; i++)
+    {
+        RK_TCB *const taskPtr = &RK_gTcbs[i];
+        if ((taskPtr->init != RK_TRUE) || (taskPtr->budgetArmed != RK_TRUE))
+        {
+            continue;
+        }
+        if (K_TICK_IS_BEFORE(now, taskPtr->budgetReplenish))
+        {
+            kBudgetArm_(taskPtr, taskPtr->budgetReplenish);
+            continue;
+        }
+        taskPtr->budgetArmed = RK_FALSE;
+        taskPtr->budgetLeft = taskPtr->budget;
+        if (taskPtr->budgetExhausted == RK_TRUE)
+        {
+            taskPtr->budgetExhausted = RK_FALSE;
+            kTaskUpdateEffectivePrioChain(taskPtr);
+            resched = RK_TRUE;
+        }
+    }
+    return (resched);
+}
+
+/* charges the tick to the running task budget */
+static inline RK_BOOL kBudgetTick_(VOID)
+{
+    RK_TCB *const runPtr = RK_gRunPtr;
+    RK_TICK const now = RK_gRunTime.globalTick;
+    RK_BOOL resched = RK_FALSE;
+
+    if ((RK_gBudgetPending == RK_TRUE) &&
+        K_TICK_IS_AFTER_EQ(now, RK_gBudgetNextReplenish))
+    {
+        resched = kBudgetReplenish_(now);
+    }
+
+    if ((runPtr->budget == 0UL) || (runPtr->status != RK_RUNNING) ||
+        (runPtr->budgetExhausted == RK_TRUE))
+    {
+        return (resched);
+    }
+
+    if (runPtr->budgetArmed == RK_FALSE)
+    {
+        /* consumption started on the tick that just went by */
+        kBudgetArm_(runPtr, K_TICK_ADD(now - 1UL, runPtr->budgetPeriod));
+    }
+
+    runPtr->budgetLeft -= 1UL;
+    if (runPtr->budgetLeft == 0UL)
+    {
+        runPtr->budgetExhausted = RK_TRUE;
+        kTaskUpdateEffectivePrioChain(runPtr);
+        resched = RK_TRUE;
+    }
+    return (resched);
+}
+#endif
+
+#if (RK_CONF_CALLOUT_TIMER == ON)
+/* timers are due on a band: the fast ones expire right here, the others in
+ * the band service task */
+static VOID kTimerDueSignal_(UINT const band)
+{
+#if ((RK_CONF_FAST_TIMER == ON) || (RK_CONF_TIMER_EVENT == ON))
+    if (kTimerFastHandle(kTimerBandList(band)) == RK_FALSE)
+    {
+        return;
+    }
+#endif
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+    if (band > 0U)
+    {
+        kEventSet(RK_gTimerBandTaskHandle[band - 1U], RK_POSTPROC_TIMER_SIG);
+        return;
+    }
+#endif
+    K_UNUSE(band);
+    kEventSet(RK_gPostProcTaskHandle, RK_POSTPROC_TIMER_SIG);
+}
+#endif
+
 UINT kTickHandler(VOID)
 {
     volatile UINT timeOutTask = RK_FALSE;
     RK_CR_AREA
     RK_CR_ENTER
+    kTickSeqBegin_();
     RK_gRunTime.globalTick += 1UL;
     kTraceTick();
     if (RK_gRunTime.globalTick == RK_TICK_TYPE_MAX)
@@ -1526,8 +2532,25 @@ UINT kTickHandler(VOID)
         RK_gRunTime.globalTick = 0UL;
         RK_gRunTime.nWraps += 1UL;
     }
+    kTickSeqEnd_();
     RK_CR_EXIT
     /* handle time out and sleeping list */
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+    if (RK_gTimeOutPendListPtr != NULL)
+    {
+        RK_CR_ENTER
+        kTimeoutPendFlush();
+        RK_CR_EXIT
+    }
+#endif
+#if (RK_CONF_TIMING_WHEEL == ON)
+    /* the wheel turns every tick */
+    RK_CR_ENTER
+
+    timeOutTask = kHandleTimeoutList();
+
+    RK_CR_EXIT
+#else
     /* the list is not empty, decrement only the head  */
     if (RK_gTimeOutListHeadPtr != NULL)
     {
@@ -1537,25 +2560,84 @@ UINT kTickHandler(VOID)
 
         RK_CR_EXIT
     }
+#endif
 
-#if (RK_CONF_CALLOUT_TIMER == ON)
-    if (RK_gTimerListHeadPtr != NULL)
+#if (RK_CONF_SCHED_TABLE == ON)
+    if ((RK_gSchTblListPtr != NULL) &&
+        K_TICK_IS_AFTER_EQ(RK_gRunTime.globalTick,
+                           RK_gSchTblListPtr->nextTick))
     {
         RK_CR_ENTER
-
-        if (RK_gTimerListHeadPtr->dtick > 0UL)
+        if (kSchTblHandle() == RK_TRUE)
         {
-            --RK_gTimerListHeadPtr->dtick;
+            timeOutTask = RK_TRUE;
         }
+        RK_CR_EXIT
+    }
+#endif
 
-        if (RK_gTimerListHeadPtr->dtick == 0UL)
+#if ((RK_CONF_CALLOUT_TIMER == ON) && (RK_CONF_TIMING_WHEEL == ON))
+    RK_CR_ENTER
+    UINT const dueBands = kHandleTimerWheel();
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
+    {
+        if ((dueBands & (1U << band)) != 0U)
+        {
+            kTimerDueSignal_(band);
+            timeOutTask = RK_TRUE;
+        }
+    }
+    RK_CR_EXIT
+#elif ((RK_CONF_CALLOUT_TIMER == ON) && (RK_CONF_ABS_TIMEOUT == ON))
+    RK_CR_ENTER
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
+    {
+        volatile RK_TIMEOUT_NODE *headPtr = *kTimerBandList(band);
+        if ((headPtr != NULL) && K_TIMEOUT_NODE_DUE(headPtr))
         {
-            kEventSet(RK_gPostProcTaskHandle, RK_POSTPROC_TIMER_SIG);
+            kTimerDueSignal_(band);
             timeOutTask = RK_TRUE;
         }
+    }
+    RK_CR_EXIT
+#elif (RK_CONF_CALLOUT_TIMER == ON)
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
+    {
+        volatile RK_TIMEOUT_NODE *headPtr = *kTimerBandList(band);
+        if (headPtr != NULL)
+        {
+            RK_CR_ENTER
 
-        RK_CR_EXIT
+            if (headPtr->dtick > 0UL)
+            {
+                --headPtr->dtick;
+            }
+
+            if (headPtr->dtick == 0UL)
+            {
+                kTimerDueSignal_(band);
+                timeOutTask = RK_TRUE;
+            }
+
+            RK_CR_EXIT
+        }
     }
+#endif
+#if (RK_CONF_CPU_BUDGET == ON)
+    RK_CR_ENTER
+    if (kBudgetTick_() == RK_TRUE)
+    {
+        timeOutTask = RK_TRUE;
+    }
+    RK_CR_EXIT
+#endif
+#if (RK_CONF_TIME_SLICE == ON)
+    RK_CR_ENTER
+    if (kTimeSliceTick_() == RK_TRUE)
+    {
+        timeOutTask = RK_TRUE;
+    }
+    RK_CR_EXIT
 #endif
     if ((RK_gRunPtr->status != RK_READY) && (timeOutTask == RK_FALSE))
     {
@@ -1568,6 +2650,12 @@ UINT kTickHandler(VOID)
         {
             return (0U);
         }
+#if (RK_CONF_PREEMPT_THRESHOLD == ON)
+        if (kRunThresholdHolds_() == RK_TRUE)
+        {
+            return (0U);
+        }
+#endif
         if (RK_gSchLock > 0UL)
         {
             kDeferCtxSwtch_();
@@ -1585,3 +2673,152 @@ UINT kTickHandler(VOID)
     RK_BARRIER
     return (1U);
 }
+
+#if (RK_CONF_TICKLESS == ON)
+/******************************************************************************/
+/* TICKLESS IDLE                                                              */
+/******************************************************************************/
+#if (RK_CONF_ABS_TIMEOUT == ON)
+/* bounds a window to the expiry tick of a list head */
+static RK_TICK kTicklessHeadTicks_(volatile RK_TIMEOUT_NODE const *headPtr,
+                                   RK_TICK const idleTicks)
+{
+    if (headPtr == NULL)
+    {
+        return (idleTicks);
+    }
+    if (K_TIMEOUT_NODE_DUE(headPtr))
+    {
+        return (0UL);
+    }
+    RK_TICK const headTicks =
+        K_TICK_DELTA(headPtr->dtick, RK_gRunTime.globalTick);
+    return ((headTicks < idleTicks) ? headTicks : idleTicks);
+}
+#endif
+
+/* ticks until the earliest armed expiry on either delta-list */
+static RK_TICK kTicklessIdleTicks_(VOID)
+{
+    RK_TICK idleTicks = (RK_TICK)kCoreTicklessMaxTicks();
+
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+    /* waits pending arming must bound the window too */
+    kTimeoutPendFlush();
+#endif
+
+#if (RK_CONF_TIMING_WHEEL == ON)
+    idleTicks = kTimingWheelIdleTicks(idleTicks);
+#elif (RK_CONF_ABS_TIMEOUT == ON)
+    idleTicks = kTicklessHeadTicks_(RK_gTimeOutListHeadPtr, idleTicks);
+#if (RK_CONF_CALLOUT_TIMER == ON)
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
+    {
+        idleTicks = kTicklessHeadTicks_(*kTimerBandList(band), idleTicks);
+    }
+#endif
+#else
+    if ((RK_gTimeOutListHeadPtr != NULL) &&
+        (RK_gTimeOutListHeadPtr->dtick < idleTicks))
+    {
+        idleTicks = RK_gTimeOutListHeadPtr->dtick;
+    }
+#if (RK_CONF_CALLOUT_TIMER == ON)
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
+    {
+        volatile RK_TIMEOUT_NODE const *headPtr = *kTimerBandList(band);
+        if ((headPtr != NULL) && (headPtr->dtick < idleTicks))
+        {
+            idleTicks = headPtr->dtick;
+        }
+    }
+#endif
+#endif
+#if (RK_CONF_SCHED_TABLE == ON)
+    if (RK_gSchTblListPtr != NULL)
+    {
+        RK_TICK const tblTicks =
+            K_TICK_DELTA(RK_gSchTblListPtr->nextTick, RK_gRunTime.globalTick);
+        if (tblTicks < idleTicks)
+        {
+            idleTicks = tblTicks;
+        }
+    }
+#endif
+    return (idleTicks);
+}
+
+/*
+ * Charges ticks that went by with the SysTick stretched. The sleep window
+ * never goes past the head of a delta-list, so nothing expires here: the
+ * heads are only brought up to date and the tick that does expire them is
+ * handled by kTickHandler().
+ */
+static VOID kTickStep_(RK_TICK const ticks)
+{
+    RK_TICK const room = RK_TICK_TYPE_MAX - RK_gRunTime.globalTick;
+
+    kTickSeqBegin_();
+    if (ticks >= room)
+    {
+        RK_gRunTime.globalTick = ticks - room;
+        RK_gRunTime.nWraps += 1UL;
+    }
+    else
+    {
+        RK_gRunTime.globalTick += ticks;
+    }
+    kTickSeqEnd_();
+
+#if (RK_CONF_TIMING_WHEEL == ON)
+    kTimingWheelStep(ticks);
+#elif (RK_CONF_ABS_TIMEOUT == ON)
+    /* absolute expiry ticks need no catch-up */
+#else
+    if (RK_gTimeOutListHeadPtr != NULL)
+    {
+        K_ASSERT(RK_gTimeOutListHeadPtr->dtick > ticks);
+        RK_gTimeOutListHeadPtr->dtick -= ticks;
+    }
+#if (RK_CONF_CALLOUT_TIMER == ON)
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
+    {
+        volatile RK_TIMEOUT_NODE *headPtr = *kTimerBandList(band);
+        if (headPtr != NULL)
+        {
+            K_ASSERT(headPtr->dtick > ticks);
+            headPtr->dtick -= ticks;
+        }
+    }
+#endif
+#endif
+}
+
+/* called from the Idle Task loop */
+VOID kTicklessIdle(VOID)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+    RK_TICK const idleTicks = kTicklessIdleTicks_();
+    if (idleTicks >= RK_CONF_TICKLESS_MIN_TICKS)
+    {
+        /* WFI wakes on a pending interrupt even with PRIMASK set; it is
+         * taken once the critical section is left */
+        RK_TICK const elapsed = (RK_TICK)kCoreTicklessSleep(idleTicks);
+        if (elapsed > 0UL)
+        {
+            kTickStep_(elapsed);
+        }
+        RK_CR_EXIT
+        return;
+    }
+    RK_CR_EXIT
+
+    RK_ISB
+
+    RK_WFI
+
+    RK_DSB
+}
+#endif
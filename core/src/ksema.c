@@ -77,6 +77,9 @@ RK_ERR kSemaphoreInit(RK_SEMAPHORE *const kobj, const UINT initValue,
         return (RK_ERR_ERROR);
     }
 #endif
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    kTCBQPrioIndexInit(&kobj->waitingQueue, &kobj->waitingQueueIdx);
+#endif
 
     kobj->init = RK_TRUE;
     kobj->objID = RK_SEMAPHORE_KOBJ_ID;
@@ -64,6 +64,9 @@ RK_ERR kSleepQueueInit(RK_SLEEP_QUEUE *const kobj)
 #endif
 
     kTCBQInit(&(kobj->waitingQueue));
+#if (RK_CONF_PRIO_WAIT_QUEUE == ON)
+    kTCBQPrioIndexInit(&kobj->waitingQueue, &kobj->waitingQueueIdx);
+#endif
     kobj->init = RK_TRUE;
     kobj->objID = RK_SLEEPQ_KOBJ_ID;
     kobj->objName[0] = '\0';
@@ -490,6 +493,9 @@ RK_ERR kSleepQueueUnready(RK_SLEEP_QUEUE *const kobj, RK_TASK_HANDLE handle)
         return (RK_ERR_INVALID_PARAM);
     }
 
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+    kReadyHandoffUndo(handle);
+#endif
     RK_TCB **const taskPPtr = (RK_TCB * *const)&handle;
     kTCBQRem(&RK_gReadyQueue[handle->priority], taskPPtr);
     RK_TCB *taskPtr = *taskPPtr;
@@ -102,6 +102,15 @@ static VOID kSynchMesgUpdateReceiverPrio_(RK_TCB *const receiverPtr)
     kTaskUpdateEffectivePrioChain(receiverPtr);
 }
 
+static inline RK_ERR kSynchMesgReady_(RK_TCB *const taskPtr)
+{
+#if (RK_CONF_SYNCH_HANDOFF == ON)
+    return (kReadyHandoff(taskPtr));
+#else
+    return (kReadySwtch(taskPtr));
+#endif
+}
+
 static VOID kSynchMesgWakeAcceptor_(RK_TCB *const serverPtr)
 {
     if ((serverPtr == NULL) || (serverPtr->synchMesgAcceptWaiters.size == 0UL))
@@ -117,7 +126,7 @@ static VOID kSynchMesgWakeAcceptor_(RK_TCB *const serverPtr)
     {
         kSynchMesgDisarmTimeout_(acceptorPtr);
     }
-    kReadySwtch(acceptorPtr);
+    kSynchMesgReady_(acceptorPtr);
 }
 
 static VOID kSynchMesgCopy_(VOID *const recvPtr,
@@ -170,7 +179,7 @@ static RK_ERR kSynchMesgDirectRecv_(RK_TCB *const receiverPtr,
         kSynchMesgDisarmTimeout_(receiverPtr);
     }
 
-    kReadySwtch(receiverPtr);
+    kSynchMesgReady_(receiverPtr);
     return (RK_ERR_SUCCESS);
 }
 
@@ -1009,7 +1018,7 @@ RK_ERR kSynchMesgReply(RK_SYNCH_CALL_DATA const *const callPtr,
     kSynchMesgClearCall_(callerPtr);
     kSynchMesgUpdateReceiverPrio_(RK_gRunPtr);
 
-    RK_ERR err = kSynchMesgPublicReadyErr_(kReadySwtch(callerPtr));
+    RK_ERR err = kSynchMesgPublicReadyErr_(kSynchMesgReady_(callerPtr));
     RK_CR_EXIT
     return (err);
 }
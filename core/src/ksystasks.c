@@ -25,6 +25,10 @@
 
 UINT RK_gIdleStack[RK_CONF_IDLE_STACKSIZE] K_ALIGN(8);
 UINT RK_gPostProcStack[RK_CONF_POSTPROC_STACKSIZE] K_ALIGN(8);
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+UINT RK_gTimerBandStack[RK_N_TIMER_BAND_TASKS]
+                      [RK_CONF_TIMER_BAND_STACKSIZE] K_ALIGN(8);
+#endif
 
 #define RK_POSTPROC_Q_LEN ((UINT)RK_NTHREADS)
 
@@ -194,13 +198,61 @@ VOID IdleTask(VOID *args)
 
     while (1)
     {
+#if (RK_CONF_TICKLESS == ON)
+        kTicklessIdle();
+#else
         RK_ISB
 
         RK_WFI
 
         RK_DSB
+#endif
+    }
+}
+
+#if (RK_CONF_CALLOUT_TIMER == ON)
+/* takes the next expired timer off a band expiry list, that the tick handler
+ * may also be working on */
+static RK_TIMER *kTimerDuePop_(volatile RK_TIMEOUT_NODE **const listRef)
+{
+    RK_TIMER *timer = NULL;
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)*listRef;
+    if ((node != NULL) && (kTimerNodeIsDue(node) == RK_TRUE))
+    {
+        kRemoveTimerNode(node);
+        timer = K_GET_CONTAINER_ADDR(node, RK_TIMER, timeoutNode);
+    }
+    RK_CR_EXIT
+    return (timer);
+}
+#endif
+
+#if (RK_N_TIMER_BAND_TASKS > 0U)
+/* serves the expiry list of a timer band, passed as argument */
+VOID TimerBandSysTask(VOID *args)
+{
+    volatile RK_TIMEOUT_NODE **const listRef =
+        (volatile RK_TIMEOUT_NODE **)args;
+
+    while (1)
+    {
+        ULONG gotFlags = 0;
+
+        kEventGet(RK_POSTPROC_TIMER_SIG, RK_OPT_EVENT_ANY, &gotFlags,
+                  RK_WAIT_FOREVER);
+
+        RK_TIMER *timer = kTimerDuePop_(listRef);
+        while (timer != NULL)
+        {
+            kTimerExpire(timer);
+            timer = kTimerDuePop_(listRef);
+        }
     }
 }
+#endif
 
 VOID PostProcSysTask(VOID *args)
 {
@@ -223,34 +275,11 @@ VOID PostProcSysTask(VOID *args)
 #if (RK_CONF_CALLOUT_TIMER == ON)
         if ((gotFlags & RK_POSTPROC_TIMER_SIG) != 0U)
         {
-            while (RK_gTimerListHeadPtr != NULL &&
-                   RK_gTimerListHeadPtr->dtick == 0)
+            RK_TIMER *timer = kTimerDuePop_(kTimerBandList(0U));
+            while (timer != NULL)
             {
-                RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)RK_gTimerListHeadPtr;
-                RK_gTimerListHeadPtr = node->nextPtr;
-                kRemoveTimerNode(node);
-
-                RK_TIMER *timer =
-                    K_GET_CONTAINER_ADDR(node, RK_TIMER, timeoutNode);
-                kTraceRecordObject(timer, RK_TRACE_OP_EXPIRE,
-                                   RK_ERR_SUCCESS, timer->reload);
-                if (timer->funPtr != NULL)
-                {
-                    timer->funPtr(timer->argsPtr);
-                }
-                if (timer->reload > 0)
-                {
-                    RK_TICK now = kTickGet();
-                    RK_TICK base = timer->nextTime;
-                    RK_TICK elapsed = K_TICK_DELTA(now, base);
-                    RK_TICK skips = ((elapsed / timer->period) + 1);
-                    RK_TICK offset = (RK_TICK)(skips * timer->period);
-                    timer->nextTime = K_TICK_ADD(base, offset);
-                    RK_TICK delay = K_TICK_DELTA(timer->nextTime, now);
-                    if (delay == 0)
-                        K_PANIC("0 DELAY TIMER");
-                    kTimerReload(timer, delay);
-                }
+                kTimerExpire(timer);
+                timer = kTimerDuePop_(kTimerBandList(0U));
             }
         }
 #endif
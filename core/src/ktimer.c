@@ -17,6 +17,13 @@
 #define RK_SOURCE_CODE
 #include "ktimer.h"
 #include <ktrace.h>
+#if ((RK_CONF_SCHED_TABLE == ON) || (RK_CONF_TIMER_EVENT == ON))
+#include <ktaskevents.h>
+#endif
+#if (RK_CONF_SCHED_TABLE == ON)
+#include <ksema.h>
+#include <kmesgq.h>
+#endif
 
 #if (RK_CONF_MUTEX == ON)
 extern VOID kMutexTimeoutWaiter(RK_TCB *const waiterPtr);
@@ -32,13 +39,29 @@ extern VOID kSynchMesgTimeoutCall(RK_TCB *const callerPtr);
 
 ULONG RK_gSysTickInterval = 0;
 
+/* an aligned word load is atomic: no critical section */
 RK_TICK kTickGet(void)
 {
-    RK_CR_AREA
-    RK_CR_ENTER
-    RK_TICK ret = (RK_gRunTime.globalTick);
-    RK_CR_EXIT
-    return (ret);
+    return (RK_gRunTime.globalTick);
+}
+
+ULLONG kTickGet64(VOID)
+{
+    ULONG seq = 0UL;
+    RK_TICK tick = 0UL;
+    UINT wraps = 0U;
+
+    do
+    {
+        seq = RK_gRunTime.tickSeq;
+        RK_DMB
+        tick = RK_gRunTime.globalTick;
+        wraps = RK_gRunTime.nWraps;
+        RK_DMB
+    } while (((seq & 1UL) != 0UL) || (seq != RK_gRunTime.tickSeq));
+
+    /* the tick count wraps to 0 when it reaches RK_TICK_TYPE_MAX */
+    return (((ULLONG)wraps * (ULLONG)RK_TICK_TYPE_MAX) + (ULLONG)tick);
 }
 
 RK_TICK kTickGetMs(VOID)
@@ -58,6 +81,72 @@ RK_TICK kTickGetMs(VOID)
     return (ret);
 }
 
+/* Samples the tick count and the core clock cycles gone by in the current
+ * tick, from the SysTick down-counter, without masking interrupts. A tick
+ * whose interrupt is still pending (masked, or not yet taken) is counted
+ * here; a tick handled while sampling makes it start over.
+ * Right after a tickless wake-up the current tick can be longer than a
+ * regular one; the count then holds at the tick boundary instead of going
+ * back. From an ISR that preempts the tick handler it can trail by a tick. */
+static inline RK_TICK kTickSample_(ULONG *const cyclesPtr)
+{
+    ULONG const cyclesPerTick = RK_gSysCoreClock / RK_CONF_SYSTICK_DIV;
+    RK_TICK tick = 0UL;
+    ULONG val = 0UL;
+    ULONG pending = 0UL;
+
+    do
+    {
+        tick = RK_gRunTime.globalTick;
+        val = RK_REG_SYSTICK_VAL;
+        pending = (RK_REG_SCB_ICSR & RK_SCB_ICSR_PENDSTSET);
+        if (pending != 0UL)
+        {
+            /* the counter reloaded: read it again past the reload */
+            val = RK_REG_SYSTICK_VAL;
+        }
+    } while (tick != RK_gRunTime.globalTick);
+
+    if (pending != 0UL)
+    {
+        tick += 1UL;
+    }
+    if (val > (cyclesPerTick - 1UL))
+    {
+        val = cyclesPerTick - 1UL;
+    }
+    *cyclesPtr = (cyclesPerTick - 1UL) - val;
+    return (tick);
+}
+
+static inline ULONG kCyclesPerUs_(VOID)
+{
+    ULONG const cycles = RK_gSysCoreClock / 1000000UL;
+    return ((cycles > 0UL) ? cycles : 1UL);
+}
+
+ULONG kTickGetCycles(VOID)
+{
+    ULONG const cyclesPerTick = RK_gSysCoreClock / RK_CONF_SYSTICK_DIV;
+    ULONG cycles = 0UL;
+    RK_TICK const tick = kTickSample_(&cycles);
+    return ((tick * cyclesPerTick) + cycles);
+}
+
+ULONG kTickGetUs(VOID)
+{
+    ULONG const usPerTick = 1000000UL / RK_CONF_SYSTICK_DIV;
+    ULONG cycles = 0UL;
+    RK_TICK const tick = kTickSample_(&cycles);
+
+    ULONG us = cycles / kCyclesPerUs_();
+    if (us > (usPerTick - 1UL))
+    {
+        us = usPerTick - 1UL;
+    }
+    return ((tick * usPerTick) + us);
+}
+
 RK_BOOL kTimeoutNodeIsArmed(RK_TIMEOUT_NODE const *node)
 {
     return (((node != NULL) && (node->listRefPtr != NULL)) ? RK_TRUE
@@ -140,6 +229,10 @@ RK_ERR kDelay(RK_TICK const ticks)
 /******************************************************************************
  * CALLOUT TIMERS
  *****************************************************************************/
+#if (RK_CONF_TIMER_BANDS > 1U)
+volatile RK_TIMEOUT_NODE *RK_gTimerBandListPtr[RK_CONF_TIMER_BANDS - 1U];
+#endif
+
 static inline RK_ERR kTimerListAdd_(RK_TIMER *kobj, RK_TICK phase,
                                     RK_TICK countTicks, RK_TIMER_CALLOUT funPtr,
                                     VOID *argsPtr, RK_OPTION reload)
@@ -151,114 +244,935 @@ static inline RK_ERR kTimerListAdd_(RK_TIMER *kobj, RK_TICK phase,
     kobj->timeoutNode.timeoutType = RK_TIMEOUT_CALL;
     kobj->funPtr = funPtr;
     kobj->argsPtr = argsPtr;
-    kobj->reload = reload;
-    kobj->phase = phase;
-    kobj->period = countTicks;
-    kobj->nextTime = K_TICK_ADD(kTickGet(), phase + countTicks);
-    return (kTimeoutNodeAdd(&kobj->timeoutNode, initialDelay));
+    kobj->reload = reload;
+    kobj->phase = phase;
+    kobj->period = countTicks;
+    kobj->nextTime = K_TICK_ADD(kTickGet(), phase + countTicks);
+    return (kTimeoutNodeAdd(&kobj->timeoutNode, initialDelay));
+}
+
+RK_ERR kTimerInit(RK_TIMER *const kobj, RK_TICK const phase,
+                  RK_TICK const countTicks, RK_TIMER_CALLOUT const funPtr,
+                  VOID *const argsPtr, RK_OPTION const reload)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+#if (RK_CONF_FAST_TIMER == ON)
+    RK_OPTION const mode = (RK_OPTION)(reload & (RK_OPTION)(~RK_TIMER_FAST));
+#else
+    RK_OPTION const mode = reload;
+#endif
+
+#if (RK_CONF_ERR_CHECK == ON)
+
+    if ((kobj == NULL) || (funPtr == NULL))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if (kobj->init == RK_TRUE)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_DOUBLE_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_DOUBLE_INIT);
+    }
+
+    if ((countTicks == 0UL) || (countTicks > RK_MAX_PERIOD) ||
+        (phase > RK_MAX_PERIOD) ||
+        (phase > (RK_MAX_PERIOD - countTicks)) ||
+        ((mode != RK_TIMER_ONESHOT) && (mode != RK_TIMER_RELOAD)))
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+#endif
+
+    if ((countTicks == 0UL) || (countTicks > RK_MAX_PERIOD) ||
+        (phase > RK_MAX_PERIOD) ||
+        (phase > (RK_MAX_PERIOD - countTicks)) ||
+        ((mode != RK_TIMER_ONESHOT) && (mode != RK_TIMER_RELOAD)))
+    {
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+#if (RK_CONF_FAST_TIMER == ON)
+    kobj->fast = ((reload & RK_TIMER_FAST) != 0U) ? RK_TRUE : RK_FALSE;
+#endif
+#if (RK_CONF_TIMER_SLACK == ON)
+    kobj->slack = 0UL;
+#endif
+#if (RK_CONF_TIMER_BANDS > 1U)
+    kobj->band = 0U;
+#endif
+    RK_ERR err =
+        kTimerListAdd_(kobj, phase, countTicks, funPtr, argsPtr, mode);
+    if (err == 0)
+    {
+        kobj->init = RK_TRUE;
+        kobj->objID = RK_TIMER_KOBJ_ID;
+        kobj->objName[0] = '\0';
+        kTraceRegisterObject(kobj, RK_TIMER_KOBJ_ID);
+    }
+    RK_CR_EXIT
+    return (err);
+}
+
+#if (RK_CONF_TIMER_EVENT == ON)
+/* callout of every event timer; runs from the tick handler */
+static VOID kTimerEventCallout_(VOID *argsPtr)
+{
+    RK_TIMER const *const kobj = (RK_TIMER const *)argsPtr;
+    RK_ERR err = kEventSet(kobj->evTaskPtr, kobj->evFlags);
+    K_ASSERT(err == RK_ERR_SUCCESS);
+    K_UNUSE(err);
+}
+
+RK_ERR kTimerInitEvent(RK_TIMER *const kobj, RK_TICK const phase,
+                       RK_TICK const countTicks,
+                       RK_TASK_HANDLE const taskHandle,
+                       RK_TASK_EVENT const flags, RK_OPTION const reload)
+{
+    if ((kobj == NULL) || (taskHandle == NULL))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+#endif
+        return (RK_ERR_OBJ_NULL);
+    }
+    if (flags == 0UL)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    /* no tick can expire it before the target is in place */
+    RK_ERR err = kTimerInit(kobj, phase, countTicks, kTimerEventCallout_,
+                            kobj, reload);
+    if (err == RK_ERR_SUCCESS)
+    {
+        kobj->evTaskPtr = taskHandle;
+        kobj->evFlags = flags;
+    }
+    RK_CR_EXIT
+    return (err);
+}
+#endif
+
+#if (RK_CONF_TIMER_SLACK == ON)
+/* Stretches a timer delay by up to its slack: onto the expiry of the first
+ * armed timer inside the window, or else up to the next multiple of the
+ * largest power of 2 within slack + 1, so timers with alike slacks meet on
+ * common ticks. */
+static RK_TICK kTimerSlackDelay_(RK_TIMER const *const kobj,
+                                 RK_TICK const delay)
+{
+    RK_TICK slack = kobj->slack;
+
+    if (slack == 0UL)
+    {
+        return (delay);
+    }
+    if (slack > (RK_MAX_PERIOD - delay))
+    {
+        slack = RK_MAX_PERIOD - delay;
+    }
+
+#if (RK_CONF_TIMING_WHEEL == OFF)
+    RK_TICK acc = 0UL;
+    RK_TIMEOUT_NODE const *nodePtr =
+        (RK_TIMEOUT_NODE const *)*kTimerBandListOf(kobj);
+    while (nodePtr != NULL)
+    {
+#if (RK_CONF_ABS_TIMEOUT == ON)
+        acc = K_TIMEOUT_NODE_DUE(nodePtr)
+                  ? 0UL
+                  : K_TICK_DELTA(nodePtr->dtick, RK_gRunTime.globalTick);
+#else
+        acc += nodePtr->dtick;
+#endif
+        if (acc >= delay)
+        {
+            if (acc <= (delay + slack))
+            {
+                return (acc);
+            }
+            break;
+        }
+        nodePtr = nodePtr->nextPtr;
+    }
+#endif
+
+    RK_TICK grid = 1UL;
+    while (grid <= ((slack + 1UL) >> 1))
+    {
+        grid <<= 1;
+    }
+#if (RK_CONF_TIMING_WHEEL == ON)
+    RK_TICK const now = RK_gWheelTick;
+#else
+    RK_TICK const now = RK_gRunTime.globalTick;
+#endif
+    RK_TICK const expiry = K_TICK_ADD(now, delay);
+    RK_TICK const aligned = K_TICK_ADD(expiry, grid - 1UL) & ~(grid - 1UL);
+    return (K_TICK_DELTA(aligned, now));
+}
+#endif
+
+VOID kTimerReload(RK_TIMER *kobj, RK_TICK delay)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+#if (RK_CONF_TIMER_SLACK == ON)
+    delay = kTimerSlackDelay_(kobj, delay);
+#endif
+    kobj->timeoutNode.timeoutType = RK_TIMEOUT_CALL;
+    RK_ERR err = kTimeoutNodeAdd(&kobj->timeoutNode, delay);
+    K_ASSERT(err == RK_ERR_SUCCESS);
+    RK_CR_EXIT
+    kTraceRecordObject(kobj, RK_TRACE_OP_RELOAD, err, delay);
+}
+
+/* runs the callout of a timer taken off the timer list and reloads it on the
+ * next period boundary after now, skipping the periods that were missed */
+VOID kTimerExpire(RK_TIMER *const kobj)
+{
+    kTraceRecordObject(kobj, RK_TRACE_OP_EXPIRE, RK_ERR_SUCCESS, kobj->reload);
+    if (kobj->funPtr != NULL)
+    {
+        kobj->funPtr(kobj->argsPtr);
+    }
+    if (kobj->reload > 0)
+    {
+        RK_TICK now = kTickGet();
+        RK_TICK base = kobj->nextTime;
+        RK_TICK elapsed = K_TICK_DELTA(now, base);
+        RK_TICK skips = ((elapsed / kobj->period) + 1);
+        RK_TICK offset = (RK_TICK)(skips * kobj->period);
+        kobj->nextTime = K_TICK_ADD(base, offset);
+        RK_TICK delay = K_TICK_DELTA(kobj->nextTime, now);
+        if (delay == 0)
+            K_PANIC("0 DELAY TIMER");
+        kTimerReload(kobj, delay);
+    }
+}
+
+#if ((RK_CONF_FAST_TIMER == ON) || (RK_CONF_TIMER_EVENT == ON))
+/* fast and event timers expire in the tick handler */
+RK_FORCE_INLINE
+static inline RK_BOOL kTimerIsFast_(RK_TIMER const *const kobj)
+{
+#if (RK_CONF_FAST_TIMER == ON)
+    if (kobj->fast == RK_TRUE)
+    {
+        return (RK_TRUE);
+    }
+#endif
+#if (RK_CONF_TIMER_EVENT == ON)
+    if (kobj->funPtr == kTimerEventCallout_)
+    {
+        return (RK_TRUE);
+    }
+#endif
+    K_UNUSE(kobj);
+    return (RK_FALSE);
+}
+
+/* runs @ systick: expires the fast timers among the due ones and tells if
+ * others are left to the Post-Processing System Task */
+UINT kTimerFastHandle(volatile RK_TIMEOUT_NODE **const listRef)
+{
+    RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)*listRef;
+    UINT pending = RK_FALSE;
+
+    while ((node != NULL) && (kTimerNodeIsDue(node) == RK_TRUE))
+    {
+        RK_TIMER *timer = K_GET_CONTAINER_ADDR(node, RK_TIMER, timeoutNode);
+        if (kTimerIsFast_(timer) == RK_TRUE)
+        {
+            kRemoveTimerNode(node);
+            kTimerExpire(timer);
+            /* the callout may have cancelled any other timer */
+            node = (RK_TIMEOUT_NODE *)*listRef;
+            pending = RK_FALSE;
+            continue;
+        }
+        pending = RK_TRUE;
+        node = node->nextPtr;
+    }
+    return (pending);
+}
+#endif
+
+VOID kRemoveTimerNode(RK_TIMEOUT_NODE *node)
+{
+    RK_ERR err = kTimeoutNodeDisarm(node);
+    K_ASSERT(err == RK_ERR_SUCCESS);
+}
+
+#if ((RK_CONF_TIMER_SLACK == ON) || (RK_CONF_TIMER_BANDS > 1U))
+/* re-arms a pending expiry under new settings; one already due is left to
+ * fire where it is */
+static VOID kTimerRearm_(RK_TIMER *const kobj)
+{
+    RK_TICK const now = RK_gRunTime.globalTick;
+    if ((kTimeoutNodeIsArmed(&kobj->timeoutNode) == RK_TRUE) &&
+        K_TICK_IS_AFTER(kobj->nextTime, now))
+    {
+        kRemoveTimerNode(&kobj->timeoutNode);
+        kTimerReload(kobj, K_TICK_DELTA(kobj->nextTime, now));
+    }
+}
+#endif
+
+#if (RK_CONF_TIMER_SLACK == ON)
+RK_ERR kTimerSetSlack(RK_TIMER *const kobj, RK_TICK const slack)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+#if (RK_CONF_ERR_CHECK == ON)
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if ((kobj->objID != RK_TIMER_KOBJ_ID) || (kobj->init != RK_TRUE))
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_OBJ);
+    }
+#endif
+    /* a slack as long as the period would make a reload skip a period */
+    if (slack >= kobj->period)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    kobj->slack = slack;
+    kTimerRearm_(kobj);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+#endif
+
+#if (RK_CONF_TIMER_BANDS > 1U)
+RK_ERR kTimerSetBand(RK_TIMER *const kobj, UINT const band)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+#if (RK_CONF_ERR_CHECK == ON)
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if ((kobj->objID != RK_TIMER_KOBJ_ID) || (kobj->init != RK_TRUE))
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_OBJ);
+    }
+#endif
+    if (band >= RK_CONF_TIMER_BANDS)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    kobj->band = band;
+    kTimerRearm_(kobj);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+#endif
+
+RK_ERR kTimerCancel(RK_TIMER *const kobj)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+#if (RK_CONF_ERR_CHECK == ON)
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if ((kobj->objID != RK_TIMER_KOBJ_ID) || (kobj->init != RK_TRUE))
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_OBJ);
+    }
+#endif
+
+    RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)&kobj->timeoutNode;
+    RK_ERR err = RK_ERR_SUCCESS;
+    if (kTimeoutNodeIsArmed(node) == RK_TRUE)
+    {
+        err = kTimeoutNodeDisarm(node);
+    }
+    kTraceRecordObject(kobj, RK_TRACE_OP_CANCEL, err, 0UL);
+
+    RK_CR_EXIT
+    return (err);
+}
+#endif
+#if (RK_CONF_SCHED_TABLE == ON)
+/*******************************************************************************
+ * SCHEDULE TABLES
+ ******************************************************************************/
+/* running tables, sorted by the tick of their next expiry point, so the tick
+handler only looks at the head */
+RK_SCHTBL *RK_gSchTblListPtr = NULL;
+
+static VOID kSchTblListRem_(RK_SCHTBL *const kobj)
+{
+    RK_SCHTBL **linkPtr = &RK_gSchTblListPtr;
+
+    while (*linkPtr != NULL)
+    {
+        if (*linkPtr == kobj)
+        {
+            *linkPtr = kobj->nextPtr;
+            break;
+        }
+        linkPtr = &((*linkPtr)->nextPtr);
+    }
+    kobj->nextPtr = NULL;
+}
+
+static VOID kSchTblListAdd_(RK_SCHTBL *const kobj)
+{
+    RK_SCHTBL **linkPtr = &RK_gSchTblListPtr;
+
+    /* behind tables due on the same tick: they keep their start order */
+    while ((*linkPtr != NULL) &&
+           K_TICK_IS_BEFORE_EQ((*linkPtr)->nextTick, kobj->nextTick))
+    {
+        linkPtr = &((*linkPtr)->nextPtr);
+    }
+    kobj->nextPtr = *linkPtr;
+    *linkPtr = kobj;
+}
+
+static inline RK_BOOL kSchTblActionValid_(RK_SCHTBL_EP const *const epPtr)
+{
+    if (epPtr->objPtr == NULL)
+    {
+        return (RK_FALSE);
+    }
+    switch (epPtr->action)
+    {
+        case RK_SCHTBL_ACT_EVENT:
+            return (RK_TRUE);
+#if (RK_CONF_SEMAPHORE == ON)
+        case RK_SCHTBL_ACT_SEMA:
+            return (RK_TRUE);
+#endif
+#if (RK_CONF_MESG_QUEUE == ON)
+        case RK_SCHTBL_ACT_MESGQ:
+            return ((epPtr->sendPtr != NULL) ? RK_TRUE : RK_FALSE);
+#endif
+        default:
+            return (RK_FALSE);
+    }
+}
+
+/* runs from the tick handler: a full queue or a saturated semaphore drops the
+release, as nothing can wait here */
+static VOID kSchTblAction_(RK_SCHTBL_EP const *const epPtr)
+{
+    RK_ERR err = RK_ERR_SUCCESS;
+
+    switch (epPtr->action)
+    {
+        case RK_SCHTBL_ACT_EVENT:
+            err = kEventSet((RK_TASK_HANDLE)epPtr->objPtr, epPtr->flags);
+            break;
+#if (RK_CONF_SEMAPHORE == ON)
+        case RK_SCHTBL_ACT_SEMA:
+            err = kSemaphorePost((RK_SEMAPHORE *)epPtr->objPtr);
+            break;
+#endif
+#if (RK_CONF_MESG_QUEUE == ON)
+        case RK_SCHTBL_ACT_MESGQ:
+            err = kMesgQueueSend((RK_MESG_QUEUE *)epPtr->objPtr,
+                                 epPtr->sendPtr, RK_NO_WAIT);
+            break;
+#endif
+        default:
+            break;
+    }
+    (VOID)err;
+}
+
+RK_ERR kSchTblInit(RK_SCHTBL *const kobj, RK_SCHTBL_EP const *const epArray,
+                   ULONG const nEp, RK_TICK const duration)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+    if ((kobj == NULL) || (epArray == NULL))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if (kobj->init == RK_TRUE)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_DOUBLE_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_DOUBLE_INIT);
+    }
+#endif
+
+    if ((nEp == 0UL) || (duration == 0UL) || (duration > RK_MAX_PERIOD))
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    for (ULONG i = 0UL; i < nEp; i++)
+    {
+        if ((epArray[i].offset >= duration) ||
+            ((i > 0UL) && (epArray[i].offset < epArray[i - 1UL].offset)) ||
+            (kSchTblActionValid_(&epArray[i]) == RK_FALSE))
+        {
+#if (RK_CONF_ERR_CHECK == ON)
+            K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+            RK_CR_EXIT
+            return (RK_ERR_INVALID_PARAM);
+        }
+    }
+
+    kobj->epArray = epArray;
+    kobj->nEp = nEp;
+    kobj->epIdx = 0UL;
+    kobj->duration = duration;
+    kobj->startTick = 0UL;
+    kobj->nextTick = 0UL;
+    kobj->running = RK_FALSE;
+    kobj->nextPtr = NULL;
+    kobj->objID = RK_SCHTBL_KOBJ_ID;
+    kobj->objName[0] = '\0';
+    kobj->init = RK_TRUE;
+    kTraceRegisterObject(kobj, RK_SCHTBL_KOBJ_ID);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+RK_ERR kSchTblStart(RK_SCHTBL *const kobj, RK_TICK const delay)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if ((kobj->init != RK_TRUE) || (kobj->objID != RK_SCHTBL_KOBJ_ID))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+#endif
+
+    if (delay > RK_MAX_PERIOD)
+    {
+#if (RK_CONF_ERR_CHECK == ON)
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
+
+    if (kobj->running == RK_TRUE)
+    {
+        kSchTblListRem_(kobj);
+    }
+    /* expiry points are only released by the tick handler: with no delay,
+    those at offset 0 are seen on the next tick */
+    kobj->epIdx = 0UL;
+    kobj->startTick = K_TICK_ADD(RK_gRunTime.globalTick, delay);
+    kobj->nextTick = K_TICK_ADD(kobj->startTick, kobj->epArray[0].offset);
+    kobj->running = RK_TRUE;
+    kSchTblListAdd_(kobj);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+RK_ERR kSchTblStop(RK_SCHTBL *const kobj)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+    if (kobj == NULL)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if ((kobj->init != RK_TRUE) || (kobj->objID != RK_SCHTBL_KOBJ_ID))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NOT_INIT);
+    }
+#endif
+
+    if (kobj->running == RK_TRUE)
+    {
+        kSchTblListRem_(kobj);
+        kobj->running = RK_FALSE;
+    }
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+/* called from the tick handler when the head table is due; fires every
+expiry point due on this tick and returns RK_TRUE if any fired */
+UINT kSchTblHandle(VOID)
+{
+    UINT fired = RK_FALSE;
+    RK_TICK const now = RK_gRunTime.globalTick;
+
+    while ((RK_gSchTblListPtr != NULL) &&
+           K_TICK_IS_AFTER_EQ(now, RK_gSchTblListPtr->nextTick))
+    {
+        RK_SCHTBL *const kobj = RK_gSchTblListPtr;
+        RK_gSchTblListPtr = kobj->nextPtr;
+        kobj->nextPtr = NULL;
+
+        kSchTblAction_(&kobj->epArray[kobj->epIdx]);
+        fired = RK_TRUE;
+
+        kobj->epIdx += 1UL;
+        if (kobj->epIdx == kobj->nEp)
+        {
+            kobj->epIdx = 0UL;
+            kobj->startTick = K_TICK_ADD(kobj->startTick, kobj->duration);
+        }
+        kobj->nextTick =
+            K_TICK_ADD(kobj->startTick, kobj->epArray[kobj->epIdx].offset);
+        kSchTblListAdd_(kobj);
+    }
+    return (fired);
+}
+#endif
+
+#if (RK_CONF_HRTIMER == ON)
+/*******************************************************************************
+ * HIGH-RESOLUTION TIMERS
+ ******************************************************************************/
+/* armed hrtimers, sorted by deadline; the hardware timer is programmed to the
+head */
+static RK_HRTIMER *RK_gHrTimerListPtr = NULL;
+
+#define K_CYCLES_IS_BEFORE(a, b) ((LONG)((ULONG)(a) - (ULONG)(b)) < 0L)
+
+/* longest delay a wrap-safe deadline can hold */
+static inline ULONG kHrMaxUs_(VOID)
+{
+    return (((ULONG)~0UL >> 1) / kCyclesPerUs_());
+}
+
+static VOID kHrTimerListRem_(RK_HRTIMER *const kobj)
+{
+    RK_HRTIMER **linkPtr = &RK_gHrTimerListPtr;
+
+    while (*linkPtr != NULL)
+    {
+        if (*linkPtr == kobj)
+        {
+            *linkPtr = kobj->nextPtr;
+            break;
+        }
+        linkPtr = &((*linkPtr)->nextPtr);
+    }
+    kobj->nextPtr = NULL;
+    kobj->armed = RK_FALSE;
+}
+
+static VOID kHrTimerListAdd_(RK_HRTIMER *const kobj)
+{
+    RK_HRTIMER **linkPtr = &RK_gHrTimerListPtr;
+
+    /* behind deadlines on the same cycle: they keep their arming order */
+    while ((*linkPtr != NULL) &&
+           !K_CYCLES_IS_BEFORE(kobj->deadline, (*linkPtr)->deadline))
+    {
+        linkPtr = &((*linkPtr)->nextPtr);
+    }
+    kobj->nextPtr = *linkPtr;
+    *linkPtr = kobj;
+    kobj->armed = RK_TRUE;
+}
+
+/* programs the hardware timer to the head deadline, or stops it */
+static VOID kHrTimerProgram_(VOID)
+{
+    if (RK_gHrTimerListPtr == NULL)
+    {
+        kCoreHrTimerStop();
+        return;
+    }
+    LONG const left = (LONG)(RK_gHrTimerListPtr->deadline - kTickGetCycles());
+    kCoreHrTimerArm((left > 0L) ? (ULONG)left : 1UL);
+}
+
+static VOID kHrTimerArm_(RK_HRTIMER *const kobj, ULONG const us)
+{
+    if (kobj->armed == RK_TRUE)
+    {
+        kHrTimerListRem_(kobj);
+    }
+    kobj->deadline = kTickGetCycles() + (us * kCyclesPerUs_());
+    kHrTimerListAdd_(kobj);
+    if (RK_gHrTimerListPtr == kobj)
+    {
+        kHrTimerProgram_();
+    }
+}
+
+RK_ERR kHrTimerInit(RK_HRTIMER *const kobj, RK_TIMER_CALLOUT const funPtr,
+                    VOID *const argsPtr)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+    if ((kobj == NULL) || (funPtr == NULL))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NULL);
+    }
+    if (kobj->init == RK_TRUE)
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_DOUBLE_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_DOUBLE_INIT);
+    }
+#endif
+
+    kobj->armed = RK_FALSE;
+    kobj->deadline = 0UL;
+    kobj->funPtr = funPtr;
+    kobj->argsPtr = argsPtr;
+    kobj->taskPtr = NULL;
+    kobj->nextPtr = NULL;
+    kobj->objID = RK_HRTIMER_KOBJ_ID;
+    kobj->init = RK_TRUE;
+    kTraceRegisterObject(kobj, RK_HRTIMER_KOBJ_ID);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
 }
 
-RK_ERR kTimerInit(RK_TIMER *const kobj, RK_TICK const phase,
-                  RK_TICK const countTicks, RK_TIMER_CALLOUT const funPtr,
-                  VOID *const argsPtr, RK_OPTION const reload)
+RK_ERR kHrTimerStart(RK_HRTIMER *const kobj, ULONG const us)
 {
     RK_CR_AREA
     RK_CR_ENTER
 
 #if (RK_CONF_ERR_CHECK == ON)
-
-    if ((kobj == NULL) || (funPtr == NULL))
+    if (kobj == NULL)
     {
         K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
         RK_CR_EXIT
         return (RK_ERR_OBJ_NULL);
     }
-    if (kobj->init == RK_TRUE)
+    if ((kobj->init != RK_TRUE) || (kobj->objID != RK_HRTIMER_KOBJ_ID))
     {
-        K_ERR_HANDLER(RK_FAULT_OBJ_DOUBLE_INIT);
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
         RK_CR_EXIT
-        return (RK_ERR_OBJ_DOUBLE_INIT);
+        return (RK_ERR_OBJ_NOT_INIT);
     }
+#endif
 
-    if ((countTicks == 0UL) || (countTicks > RK_MAX_PERIOD) ||
-        (phase > RK_MAX_PERIOD) ||
-        (phase > (RK_MAX_PERIOD - countTicks)) ||
-        ((reload != RK_TIMER_ONESHOT) && (reload != RK_TIMER_RELOAD)))
+    if ((us == 0UL) || (us > kHrMaxUs_()))
     {
+#if (RK_CONF_ERR_CHECK == ON)
         K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+#endif
         RK_CR_EXIT
         return (RK_ERR_INVALID_PARAM);
     }
 
-#endif
+    kHrTimerArm_(kobj, us);
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
 
-    if ((countTicks == 0UL) || (countTicks > RK_MAX_PERIOD) ||
-        (phase > RK_MAX_PERIOD) ||
-        (phase > (RK_MAX_PERIOD - countTicks)) ||
-        ((reload != RK_TIMER_ONESHOT) && (reload != RK_TIMER_RELOAD)))
+RK_ERR kHrTimerCancel(RK_HRTIMER *const kobj)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+#if (RK_CONF_ERR_CHECK == ON)
+    if (kobj == NULL)
     {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
         RK_CR_EXIT
-        return (RK_ERR_INVALID_PARAM);
+        return (RK_ERR_OBJ_NULL);
+    }
+    if ((kobj->init != RK_TRUE) || (kobj->objID != RK_HRTIMER_KOBJ_ID))
+    {
+        K_ERR_HANDLER(RK_FAULT_OBJ_NOT_INIT);
+        RK_CR_EXIT
+        return (RK_ERR_OBJ_NOT_INIT);
     }
+#endif
 
-    RK_ERR err =
-        kTimerListAdd_(kobj, phase, countTicks, funPtr, argsPtr, reload);
-    if (err == 0)
+    if (kobj->armed == RK_TRUE)
     {
-        kobj->init = RK_TRUE;
-        kobj->objID = RK_TIMER_KOBJ_ID;
-        kobj->objName[0] = '\0';
-        kTraceRegisterObject(kobj, RK_TIMER_KOBJ_ID);
+        RK_BOOL const wasHead = (RK_gHrTimerListPtr == kobj) ? RK_TRUE
+                                                             : RK_FALSE;
+        kHrTimerListRem_(kobj);
+        if (wasHead == RK_TRUE)
+        {
+            kHrTimerProgram_();
+        }
     }
     RK_CR_EXIT
-    return (err);
-}
-
-VOID kTimerReload(RK_TIMER *kobj, RK_TICK delay)
-{
-    kobj->timeoutNode.timeoutType = RK_TIMEOUT_CALL;
-    RK_ERR err = kTimeoutNodeAdd(&kobj->timeoutNode, delay);
-    K_ASSERT(err == RK_ERR_SUCCESS);
-    kTraceRecordObject(kobj, RK_TRACE_OP_RELOAD, err, delay);
-}
-
-VOID kRemoveTimerNode(RK_TIMEOUT_NODE *node)
-{
-    RK_ERR err = kTimeoutNodeDisarm(node);
-    K_ASSERT(err == RK_ERR_SUCCESS);
+    return (RK_ERR_SUCCESS);
 }
 
-RK_ERR kTimerCancel(RK_TIMER *const kobj)
+RK_ERR kSleepUs(ULONG const us)
 {
     RK_CR_AREA
     RK_CR_ENTER
 #if (RK_CONF_ERR_CHECK == ON)
-    if (kobj == NULL)
+    if (kIsISR())
     {
-        K_ERR_HANDLER(RK_FAULT_OBJ_NULL);
+        K_ERR_HANDLER(RK_FAULT_INVALID_ISR_PRIMITIVE);
         RK_CR_EXIT
-        return (RK_ERR_OBJ_NULL);
+        return (RK_ERR_INVALID_ISR_PRIMITIVE);
     }
-    if ((kobj->objID != RK_TIMER_KOBJ_ID) || (kobj->init != RK_TRUE))
+    if (RK_gRunPtr->status != RK_RUNNING)
     {
-        K_ERR_HANDLER(RK_FAULT_INVALID_OBJ);
+        K_ERR_HANDLER(RK_FAULT_TASK_INVALID_STATE);
         RK_CR_EXIT
-        return (RK_ERR_INVALID_OBJ);
+        return (RK_ERR_TASK_INVALID_ST);
+    }
+    if (us > kHrMaxUs_())
+    {
+        K_ERR_HANDLER(RK_FAULT_INVALID_PARAM);
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
     }
 #endif
+    if (us == 0UL)
+    {
+        RK_CR_EXIT
+        return (RK_ERR_TIMEOUT);
+    }
+    if (us > kHrMaxUs_())
+    {
+        RK_CR_EXIT
+        return (RK_ERR_INVALID_PARAM);
+    }
 
-    RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)&kobj->timeoutNode;
-    RK_ERR err = RK_ERR_SUCCESS;
-    if (kTimeoutNodeIsArmed(node) == RK_TRUE)
+    /* lives on the sleeper stack; it is off the list before the task runs
+    again */
+    RK_HRTIMER sleepTimer;
+    sleepTimer.objID = RK_HRTIMER_KOBJ_ID;
+    sleepTimer.init = RK_TRUE;
+    sleepTimer.armed = RK_FALSE;
+    sleepTimer.funPtr = NULL;
+    sleepTimer.argsPtr = NULL;
+    sleepTimer.taskPtr = RK_gRunPtr;
+    sleepTimer.nextPtr = NULL;
+    kHrTimerArm_(&sleepTimer, us);
+
+    RK_gRunPtr->status = RK_SLEEPING_DELAY;
+    kPendCtxSwtch();
+    RK_CR_EXIT
+    return (RK_ERR_SUCCESS);
+}
+
+/* drops the kSleepUs() deadline of a task being terminated */
+VOID kHrTimerCancelTask(RK_TCB *const taskPtr)
+{
+    RK_HRTIMER *kobj = RK_gHrTimerListPtr;
+
+    while (kobj != NULL)
     {
-        err = kTimeoutNodeDisarm(node);
+        if (kobj->taskPtr == taskPtr)
+        {
+            RK_BOOL const wasHead = (RK_gHrTimerListPtr == kobj) ? RK_TRUE
+                                                                 : RK_FALSE;
+            kHrTimerListRem_(kobj);
+            if (wasHead == RK_TRUE)
+            {
+                kHrTimerProgram_();
+            }
+            return;
+        }
+        kobj = kobj->nextPtr;
     }
-    kTraceRecordObject(kobj, RK_TRACE_OP_CANCEL, err, 0UL);
+}
+
+/* called from the hardware timer ISR: expires every due deadline and
+programs the next one */
+VOID kHrTimerHandler(VOID)
+{
+    RK_CR_AREA
+    RK_CR_ENTER
+
+    while ((RK_gHrTimerListPtr != NULL) &&
+           !K_CYCLES_IS_BEFORE(kTickGetCycles(),
+                               RK_gHrTimerListPtr->deadline))
+    {
+        RK_HRTIMER *const kobj = RK_gHrTimerListPtr;
+        RK_gHrTimerListPtr = kobj->nextPtr;
+        kobj->nextPtr = NULL;
+        kobj->armed = RK_FALSE;
 
+        if (kobj->taskPtr != NULL)
+        {
+            if (kobj->taskPtr->status == RK_SLEEPING_DELAY)
+            {
+                RK_ERR err = kReadySwtch(kobj->taskPtr);
+                K_UNUSE(err);
+            }
+            continue;
+        }
+        /* the callout may arm or cancel any hrtimer */
+        RK_CR_EXIT
+        kobj->funPtr(kobj->argsPtr);
+        RK_CR_ENTER
+    }
+    kHrTimerProgram_();
     RK_CR_EXIT
-    return (err);
 }
 #endif
+
 /*******************************************************************************
  * SLEEP TIMER AND BLOCKING TIME-OUT
  ******************************************************************************/
@@ -389,6 +1303,9 @@ RK_ERR kSleepRelease(RK_TICK period)
 #endif
     }
     RK_gRunPtr->wakeTime = nextWake;
+#if (RK_CONF_EDF == ON)
+    kTaskDeadlineRelease(RK_gRunPtr, nextWake);
+#endif
     RK_TASK_SLEEP_TIMEOUT_SETUP
     RK_ERR err = kTimeoutNodeAdd(&RK_gRunPtr->timeoutNode, delay);
     if (err != RK_ERR_SUCCESS)
@@ -447,6 +1364,10 @@ RK_ERR kSleepUntil(RK_TICK *lastTickPtr, RK_TICK const ticks)
     /* advance   */
     *lastTickPtr = K_TICK_ADD(*lastTickPtr, ticks);
 
+#if (RK_CONF_EDF == ON)
+    kTaskDeadlineRelease(RK_gRunPtr, *lastTickPtr);
+#endif
+
     /* late or on-time  */
     if (kTickIsElapsed(*lastTickPtr, now))
     {
@@ -472,6 +1393,136 @@ RK_ERR kSleepUntil(RK_TICK *lastTickPtr, RK_TICK const ticks)
     return (RK_ERR_SUCCESS);
 }
 
+#if ((RK_CONF_TIMING_WHEEL == ON) || (RK_CONF_LAZY_TIMEOUT == ON))
+static void kTimeoutListPush_(RK_TIMEOUT_NODE **headPtr, RK_TIMEOUT_NODE *node)
+{
+    node->prevPtr = NULL;
+    node->nextPtr = *headPtr;
+    if (*headPtr != NULL)
+    {
+        (*headPtr)->prevPtr = node;
+    }
+    *headPtr = node;
+}
+#endif
+
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+/* bounded waits that began after the last tick boundary */
+volatile RK_TIMEOUT_NODE *RK_gTimeOutPendListPtr = NULL;
+#endif
+
+#if (RK_CONF_TIMING_WHEEL == ON)
+/******************************************************************************/
+/* TIMING WHEEL                                                               */
+/******************************************************************************/
+/* An armed node is hashed onto the slot of its expiry tick, which it keeps in
+ * dtick. The wheel counts ticks on its own, so the slot sequence does not skip
+ * when the global tick wraps. */
+#define K_WHEEL_SLOT(tick) ((tick) & (RK_CONF_TIMING_WHEEL_SLOTS - 1UL))
+
+RK_TICK RK_gWheelTick = 0UL;
+volatile RK_TIMEOUT_NODE *RK_gTimeOutWheel[RK_CONF_TIMING_WHEEL_SLOTS];
+#if (RK_CONF_CALLOUT_TIMER == ON)
+volatile RK_TIMEOUT_NODE *RK_gTimerWheel[RK_CONF_TIMING_WHEEL_SLOTS];
+#endif
+
+/* ticks until the next slot holding any node; nodes there may be laps away,
+ * so this only bounds a tickless window */
+RK_TICK kTimingWheelIdleTicks(RK_TICK const maxTicks)
+{
+    RK_TICK ticks = 1UL;
+
+    while ((ticks <= maxTicks) && (ticks <= RK_CONF_TIMING_WHEEL_SLOTS))
+    {
+        ULONG const slot = K_WHEEL_SLOT(RK_gWheelTick + ticks);
+        if (RK_gTimeOutWheel[slot] != NULL)
+        {
+            return (ticks);
+        }
+#if (RK_CONF_CALLOUT_TIMER == ON)
+        if (RK_gTimerWheel[slot] != NULL)
+        {
+            return (ticks);
+        }
+#endif
+        ticks++;
+    }
+    return (maxTicks);
+}
+
+/* ticks that went by with the tick stretched cross empty slots only */
+VOID kTimingWheelStep(RK_TICK const ticks)
+{
+    RK_gWheelTick += ticks;
+}
+
+#if (RK_CONF_CALLOUT_TIMER == ON)
+/* moves the timers expiring on this tick to the expiry list of their band,
+ * drained by its service task, and returns the mask of those bands; runs @
+ * systick after kHandleTimeoutList() */
+UINT kHandleTimerWheel(VOID)
+{
+    volatile RK_TIMEOUT_NODE **slotRef =
+        &RK_gTimerWheel[K_WHEEL_SLOT(RK_gWheelTick)];
+    RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)*slotRef;
+    UINT expired = 0U;
+
+    while (node != NULL)
+    {
+        RK_TIMEOUT_NODE *nextPtr = node->nextPtr;
+        if (node->dtick == RK_gWheelTick)
+        {
+            RK_ERR err = kRemoveTimeoutNode(node);
+            K_ASSERT(err == RK_ERR_SUCCESS);
+            K_UNUSE(err);
+            RK_TIMER const *timer =
+                K_GET_CONTAINER_ADDR(node, RK_TIMER, timeoutNode);
+            node->dtick = 0UL;
+            node->listRefPtr = kTimerBandListOf(timer);
+            kTimeoutListPush_((RK_TIMEOUT_NODE **)node->listRefPtr, node);
+#if (RK_CONF_TIMER_BANDS > 1U)
+            expired |= (1U << timer->band);
+#else
+            expired = 1U;
+#endif
+        }
+        node = nextPtr;
+    }
+    return (expired);
+}
+#endif
+#elif (RK_CONF_ABS_TIMEOUT == ON)
+/* sorted by expiry tick; a node goes after those expiring on the same tick */
+static void kTimeoutListInsertDelta_(RK_TIMEOUT_NODE **headPtr,
+                                     RK_TIMEOUT_NODE *node)
+{
+    RK_TIMEOUT_NODE *currPtr = *headPtr;
+    RK_TIMEOUT_NODE *prevPtr = NULL;
+
+    while (currPtr != NULL && K_TICK_IS_BEFORE_EQ(currPtr->dtick, node->dtick))
+    {
+        prevPtr = currPtr;
+        currPtr = currPtr->nextPtr;
+    }
+
+    node->nextPtr = currPtr;
+    node->prevPtr = prevPtr;
+
+    if (currPtr != NULL)
+    {
+        currPtr->prevPtr = node;
+    }
+
+    if (prevPtr != NULL)
+    {
+        prevPtr->nextPtr = node;
+    }
+    else
+    {
+        *headPtr = node;
+    }
+}
+#else
 static void kTimeoutListInsertDelta_(RK_TIMEOUT_NODE **headPtr,
                                      RK_TIMEOUT_NODE *node)
 {
@@ -504,18 +1555,31 @@ static void kTimeoutListInsertDelta_(RK_TIMEOUT_NODE **headPtr,
         *headPtr = node;
     }
 }
+#endif
 
 RK_FORCE_INLINE static inline volatile RK_TIMEOUT_NODE **
 kTimeoutNodeListRef_(RK_TIMEOUT_NODE *const node)
 {
+#if (RK_CONF_TIMING_WHEEL == ON)
+    ULONG const slot = K_WHEEL_SLOT(node->dtick);
+#if (RK_CONF_CALLOUT_TIMER == ON)
+    if (node->timeoutType == RK_TIMEOUT_CALL)
+    {
+        return (&RK_gTimerWheel[slot]);
+    }
+#endif
+    return (&RK_gTimeOutWheel[slot]);
+#else
 #if (RK_CONF_CALLOUT_TIMER == ON)
     if (node->timeoutType == RK_TIMEOUT_CALL)
     {
-        return (&RK_gTimerListHeadPtr);
+        return (kTimerBandListOf(
+            K_GET_CONTAINER_ADDR(node, RK_TIMER, timeoutNode)));
     }
 #endif
     K_UNUSE(node);
     return (&RK_gTimeOutListHeadPtr);
+#endif
 }
 
 /* add caller to timeout list (delta-list) */
@@ -569,14 +1633,60 @@ RK_ERR kTimeoutNodeAdd(RK_TIMEOUT_NODE *timeOutNode, RK_TICK timeout)
     timeOutNode->timeout = timeout;
     timeOutNode->prevPtr = NULL;
     timeOutNode->nextPtr = NULL;
+#if (RK_CONF_TIMING_WHEEL == ON)
+    timeOutNode->dtick = K_TICK_ADD(RK_gWheelTick, timeout);
+#elif (RK_CONF_ABS_TIMEOUT == ON)
+    timeOutNode->dtick = K_TICK_ADD(RK_gRunTime.globalTick, timeout);
+#else
     timeOutNode->dtick = timeout;
+#endif
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+    /* a sleep always outlives the tick; other waits are armed lazily */
+    if ((timeOutNode->timeoutType != RK_TIMEOUT_CALL) &&
+        (timeOutNode->timeoutType != RK_TIMEOUT_TIME_EVENT))
+    {
+        timeOutNode->listRefPtr = &RK_gTimeOutPendListPtr;
+        kTimeoutListPush_((RK_TIMEOUT_NODE **)timeOutNode->listRefPtr,
+                          timeOutNode);
+        return (RK_ERR_SUCCESS);
+    }
+#endif
     timeOutNode->listRefPtr = kTimeoutNodeListRef_(timeOutNode);
-
+#if (RK_CONF_TIMING_WHEEL == ON)
+    kTimeoutListPush_((RK_TIMEOUT_NODE **)timeOutNode->listRefPtr,
+                      timeOutNode);
+#else
     kTimeoutListInsertDelta_((RK_TIMEOUT_NODE **)timeOutNode->listRefPtr,
                              timeOutNode);
+#endif
 
     return (RK_ERR_SUCCESS);
 }
+
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+/* arms the bounded waits still blocked at a tick boundary. It runs before the
+ * time-out list is handled, so a wait is charged from the tick it began. */
+VOID kTimeoutPendFlush(VOID)
+{
+    while (RK_gTimeOutPendListPtr != NULL)
+    {
+        RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)RK_gTimeOutPendListPtr;
+        RK_gTimeOutPendListPtr = node->nextPtr;
+        if (node->nextPtr != NULL)
+        {
+            node->nextPtr->prevPtr = NULL;
+        }
+        node->listRefPtr = kTimeoutNodeListRef_(node);
+#if (RK_CONF_TIMING_WHEEL == ON)
+        kTimeoutListPush_((RK_TIMEOUT_NODE **)node->listRefPtr, node);
+#else
+        node->nextPtr = NULL;
+        node->prevPtr = NULL;
+        kTimeoutListInsertDelta_((RK_TIMEOUT_NODE **)node->listRefPtr, node);
+#endif
+    }
+}
+#endif
 /* Ready the task associated to a time-out node, accordingly to its time-out
  * type */
 
@@ -709,6 +1819,62 @@ RK_ERR kTimeoutNodeReady(volatile RK_TIMEOUT_NODE *node)
 
 /* runs @ systick */
 static volatile RK_TIMEOUT_NODE *nodeg;
+#if (RK_CONF_TIMING_WHEEL == ON)
+/* advances the wheel one tick and readies what expires on the new slot */
+UINT kHandleTimeoutList(VOID)
+{
+    RK_ERR waitingExp = -1;
+
+    RK_gWheelTick += 1UL;
+
+    volatile RK_TIMEOUT_NODE **slotRef =
+        &RK_gTimeOutWheel[K_WHEEL_SLOT(RK_gWheelTick)];
+    RK_TIMEOUT_NODE *node = (RK_TIMEOUT_NODE *)*slotRef;
+
+    while (node != NULL)
+    {
+        RK_TIMEOUT_NODE *nextPtr = node->nextPtr;
+        if (node->dtick == RK_gWheelTick)
+        {
+            nodeg = node;
+            waitingExp = kRemoveTimeoutNode(node);
+            K_ASSERT(waitingExp == RK_ERR_SUCCESS);
+            if (waitingExp != RK_ERR_SUCCESS)
+            {
+                return (RK_FALSE);
+            }
+            waitingExp = kTimeoutNodeReady(nodeg);
+            /* readying may have disarmed the successor (e.g., the peer of a
+             * synchronous call); rescan the slot then */
+            if ((nextPtr != NULL) && (nextPtr->listRefPtr != slotRef))
+            {
+                nextPtr = (RK_TIMEOUT_NODE *)*slotRef;
+            }
+        }
+        node = nextPtr;
+    }
+    return (waitingExp == RK_ERR_SUCCESS);
+}
+#elif (RK_CONF_ABS_TIMEOUT == ON)
+UINT kHandleTimeoutList(VOID)
+{
+    RK_ERR waitingExp = -1;
+
+    while ((RK_gTimeOutListHeadPtr != NULL) &&
+           K_TIMEOUT_NODE_DUE(RK_gTimeOutListHeadPtr))
+    {
+        nodeg = RK_gTimeOutListHeadPtr;
+        waitingExp = kRemoveTimeoutNode((RK_TIMEOUT_NODE *)nodeg);
+        K_ASSERT(waitingExp == RK_ERR_SUCCESS);
+        if (waitingExp != RK_ERR_SUCCESS)
+        {
+            return (RK_FALSE);
+        }
+        waitingExp = kTimeoutNodeReady(nodeg);
+    }
+    return (waitingExp == RK_ERR_SUCCESS);
+}
+#else
 UINT kHandleTimeoutList(VOID)
 {
 
@@ -733,6 +1899,7 @@ UINT kHandleTimeoutList(VOID)
     }
     return (waitingExp == RK_ERR_SUCCESS);
 }
+#endif
 RK_ERR kRemoveTimeoutNode(RK_TIMEOUT_NODE *node)
 {
     if (node == NULL)
@@ -745,7 +1912,15 @@ RK_ERR kRemoveTimeoutNode(RK_TIMEOUT_NODE *node)
 
     if (node->nextPtr != NULL)
     {
-        node->nextPtr->dtick += node->dtick;
+#if ((RK_CONF_TIMING_WHEEL == OFF) && (RK_CONF_ABS_TIMEOUT == OFF))
+#if (RK_CONF_LAZY_TIMEOUT == ON)
+        /* pending nodes hold their whole time-out, not a delta */
+        if (node->listRefPtr != &RK_gTimeOutPendListPtr)
+#endif
+        {
+            node->nextPtr->dtick += node->dtick;
+        }
+#endif
         node->nextPtr->prevPtr = node->prevPtr;
     }
 
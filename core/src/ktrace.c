@@ -250,6 +250,10 @@ static CHAR *kTraceObjNameBuf_(VOID *const objPtr, RK_ID const objID)
     {
         case RK_MEMALLOC_KOBJ_ID:
             return (((RK_MEM_PARTITION *)objPtr)->objName);
+#if (RK_CONF_HEAP == ON)
+        case RK_HEAP_KOBJ_ID:
+            return (((RK_HEAP *)objPtr)->objName);
+#endif
 #if (RK_CONF_SEMAPHORE == ON)
         case RK_SEMAPHORE_KOBJ_ID:
             return (((RK_SEMAPHORE *)objPtr)->objName);
@@ -273,6 +277,10 @@ static CHAR *kTraceObjNameBuf_(VOID *const objPtr, RK_ID const objID)
 #if (RK_CONF_CALLOUT_TIMER == ON)
         case RK_TIMER_KOBJ_ID:
             return (((RK_TIMER *)objPtr)->objName);
+#endif
+#if (RK_CONF_SCHED_TABLE == ON)
+        case RK_SCHTBL_KOBJ_ID:
+            return (((RK_SCHTBL *)objPtr)->objName);
 #endif
         default:
             return (NULL);
@@ -345,6 +353,10 @@ static const CHAR *kTraceObjName_(RK_ID const objID)
     {
         case RK_MEMALLOC_KOBJ_ID:
             return ("mem");
+#if (RK_CONF_HEAP == ON)
+        case RK_HEAP_KOBJ_ID:
+            return ("heap");
+#endif
 #if (RK_CONF_SLEEP_QUEUE == ON)
         case RK_SLEEPQ_KOBJ_ID:
             return ("sleepq");
@@ -368,6 +380,14 @@ static const CHAR *kTraceObjName_(RK_ID const objID)
 #if (RK_CONF_CALLOUT_TIMER == ON)
         case RK_TIMER_KOBJ_ID:
             return ("timer");
+#endif
+#if (RK_CONF_SCHED_TABLE == ON)
+        case RK_SCHTBL_KOBJ_ID:
+            return ("schtbl");
+#endif
+#if (RK_CONF_HRTIMER == ON)
+        case RK_HRTIMER_KOBJ_ID:
+            return ("hrtimer");
 #endif
         default:
             return ("?");
@@ -569,6 +589,21 @@ static RK_TICK kTraceTimerRemaining_(RK_TIMER const *const timerPtr)
     }
 
     nodePtr = &timerPtr->timeoutNode;
+#if (RK_CONF_TIMING_WHEEL == ON)
+    /* unarmed, or expired and waiting for the Post-Processing Task */
+    if ((nodePtr->listRefPtr == NULL) ||
+        (nodePtr->listRefPtr == kTimerBandListOf(timerPtr)))
+    {
+        return (0UL);
+    }
+    remaining = K_TICK_DELTA(nodePtr->dtick, RK_gWheelTick);
+#elif (RK_CONF_ABS_TIMEOUT == ON)
+    if ((nodePtr->listRefPtr == NULL) || K_TIMEOUT_NODE_DUE(nodePtr))
+    {
+        return (0UL);
+    }
+    remaining = K_TICK_DELTA(nodePtr->dtick, RK_gRunTime.globalTick);
+#else
     while (nodePtr != NULL)
     {
         remaining += nodePtr->dtick;
@@ -578,6 +613,7 @@ static RK_TICK kTraceTimerRemaining_(RK_TIMER const *const timerPtr)
         }
         nodePtr = nodePtr->prevPtr;
     }
+#endif
     return (remaining);
 }
 #endif
@@ -2237,6 +2273,45 @@ static VOID kTracePrintKobjects_(VOID)
     }
 }
 
+#if (RK_CONF_HEAP == ON)
+static VOID kTracePrintKheap_(VOID)
+{
+    printf("\r\nHEAP     USED/TOTAL    PEAK BLKS FAIL POOL\r\n");
+    for (UINT i = 0U; i < RK_CONF_TRACE_MAX_OBJECTS; i++)
+    {
+        RK_HEAP const *objPtr = NULL;
+        CHAR name[RK_NAME_SIZE];
+        RK_HEAP_STATS stats = {0};
+        VOID *poolPtr = NULL;
+
+        name[0] = '\0';
+        RK_CR_AREA
+        RK_CR_ENTER
+        if ((i < traceObjectCount) &&
+            (traceObjects[i].objID == RK_HEAP_KOBJ_ID))
+        {
+            objPtr = (RK_HEAP const *)traceObjects[i].objPtr;
+            if ((objPtr != NULL) && (objPtr->init == RK_TRUE))
+            {
+                kTraceNameCopy_(name, objPtr->objName);
+                stats = objPtr->stats;
+                poolPtr = objPtr->poolPtr;
+            }
+        }
+        RK_CR_EXIT
+
+        if (objPtr == NULL)
+        {
+            continue;
+        }
+
+        printf("%-8s %5lu/%-6lu %6lu %4lu %4lu %p\r\n",
+               name, stats.usedBytes, stats.totalBytes, stats.peakUsedBytes,
+               stats.nAllocated, stats.nFailed, poolPtr);
+    }
+}
+#endif
+
 static VOID kTracePrintKmem_(VOID)
 {
 #if ((RK_CONF_ASYNCH_MESG == ON) && (RK_CONF_MESG_QUEUE == ON))
@@ -2305,6 +2380,9 @@ static VOID kTracePrintKmem_(VOID)
                name, blkSize, freeBlocks, maxBlocks, waiting, poolPtr);
 #endif
     }
+#if (RK_CONF_HEAP == ON)
+    kTracePrintKheap_();
+#endif
 }
 
 #if ((RK_CONF_SEMAPHORE == ON) || (RK_CONF_MUTEX == ON))
@@ -2447,31 +2525,71 @@ static VOID kTracePrintKtimers_(VOID)
     }
 }
 
+#if (RK_CONF_TIMING_WHEEL == ON)
+static VOID kTracePrintKtimerq_(VOID)
+{
+    UINT idx = 0U;
+
+    printf("\r\nIDX NAME     SLOT  LEFT PHASE PERIOD NEXT (TICKS)\r\n");
+
+    RK_CR_AREA
+    RK_CR_ENTER
+    for (ULONG slot = 0UL; slot < RK_CONF_TIMING_WHEEL_SLOTS; slot++)
+    {
+        RK_TIMEOUT_NODE const *nodePtr =
+            (RK_TIMEOUT_NODE const *)RK_gTimerWheel[slot];
+        while (nodePtr != NULL)
+        {
+            RK_TIMER const *timerPtr =
+                K_GET_CONTAINER_ADDR(nodePtr, RK_TIMER, timeoutNode);
+            printf("%3u %-8s %5lu %5lu %5lu %6lu %lu\r\n",
+                   idx, timerPtr->objName, slot,
+                   K_TICK_DELTA(nodePtr->dtick, RK_gWheelTick),
+                   timerPtr->phase, timerPtr->period, timerPtr->nextTime);
+            nodePtr = nodePtr->nextPtr;
+            idx++;
+        }
+    }
+    RK_CR_EXIT
+}
+#else
 static VOID kTracePrintKtimerq_(VOID)
 {
-    RK_TICK acc = 0UL;
     UINT idx = 0U;
 
     printf("\r\nIDX NAME     DELTA ACCUM PHASE PERIOD NEXT (TICKS)\r\n");
 
     RK_CR_AREA
     RK_CR_ENTER
-    RK_TIMEOUT_NODE const *nodePtr =
-        (RK_TIMEOUT_NODE const *)RK_gTimerListHeadPtr;
-    while (nodePtr != NULL)
+    for (UINT band = 0U; band < RK_CONF_TIMER_BANDS; band++)
     {
-        RK_TIMER const *timerPtr =
-            K_GET_CONTAINER_ADDR(nodePtr, RK_TIMER, timeoutNode);
-        acc += nodePtr->dtick;
-        printf("%3u %-8s %5lu %5lu %5lu %6lu %lu\r\n",
-               idx, timerPtr->objName, nodePtr->dtick, acc,
-               timerPtr->phase, timerPtr->period, timerPtr->nextTime);
-        nodePtr = nodePtr->nextPtr;
-        idx++;
+        RK_TICK acc = 0UL;
+        RK_TIMEOUT_NODE const *nodePtr =
+            (RK_TIMEOUT_NODE const *)*kTimerBandList(band);
+        while (nodePtr != NULL)
+        {
+            RK_TIMER const *timerPtr =
+                K_GET_CONTAINER_ADDR(nodePtr, RK_TIMER, timeoutNode);
+#if (RK_CONF_ABS_TIMEOUT == ON)
+            RK_TICK const left = K_TIMEOUT_NODE_DUE(nodePtr) ? 0UL :
+                K_TICK_DELTA(nodePtr->dtick, RK_gRunTime.globalTick);
+            RK_TICK const delta = left - acc;
+            acc = left;
+#else
+            RK_TICK const delta = nodePtr->dtick;
+            acc += delta;
+#endif
+            printf("%3u %-8s %5lu %5lu %5lu %6lu %lu\r\n",
+                   idx, timerPtr->objName, delta, acc,
+                   timerPtr->phase, timerPtr->period, timerPtr->nextTime);
+            nodePtr = nodePtr->nextPtr;
+            idx++;
+        }
     }
     RK_CR_EXIT
 }
 #endif
+#endif
 
 static VOID kTracePrintHistSlot_(RK_TRACE_OBJECT_SLOT const *const slotPtr)
 {